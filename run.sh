@@ -17,6 +17,7 @@ QEMU_SYSTEM_AARCH64="qemu-system-aarch64"
 UEFI_CODE_PATH="/usr/share/AAVMF/AAVMF_CODE.fd"
 UEFI_VARS_PATH="/usr/share/AAVMF/AAVMF_VARS.fd"
 LOCAL_VARS_PATH="./AAVMF_VARS_copy.fd"
+QEMU_SMP="${SMP:-4}"
 
 print_banner() {
     echo -e "${BLUE}"
@@ -138,6 +139,7 @@ start_qemu_console() {
     $QEMU_SYSTEM_AARCH64 \
         -machine virt,gic-version=3 \
         -cpu cortex-a57 \
+        -smp "$QEMU_SMP" \
         -m 512 \
         -drive if=pflash,format=raw,file="$UEFI_CODE_PATH",readonly=on \
         -drive if=pflash,format=raw,file="$LOCAL_VARS_PATH" \
@@ -159,6 +161,7 @@ start_qemu_vnc() {
     } | $QEMU_SYSTEM_AARCH64 \
         -machine virt,gic-version=3 \
         -cpu cortex-a57 \
+        -smp "$QEMU_SMP" \
         -m 512 \
         -drive if=pflash,format=raw,file="$UEFI_CODE_PATH",readonly=on \
         -drive if=pflash,format=raw,file="$LOCAL_VARS_PATH" \
@@ -205,6 +208,7 @@ main() {
             timeout 30 $QEMU_SYSTEM_AARCH64 \
                 -machine virt,gic-version=3 \
                 -cpu cortex-a57 \
+                -smp "$QEMU_SMP" \
                 -m 512 \
                 -drive if=pflash,format=raw,file="$UEFI_CODE_PATH",readonly=on \
                 -drive if=pflash,format=raw,file="$LOCAL_VARS_PATH" \
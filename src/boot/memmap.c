@@ -0,0 +1,102 @@
+/*
+ * RLOS - UEFI memory map conversion
+ *
+ * 与 uefiapp.c 分开，只依赖 EFI 类型定义，便于在主机上测试
+ */
+
+#include <efi.h>
+#include <efilib.h>
+#include "stdint.h"
+#include "boot_info.h"
+
+#define MAX_MEMORY_DESCRIPTORS 512
+static memory_descriptor_t static_memory_descriptors[MAX_MEMORY_DESCRIPTORS];
+
+EFI_STATUS ConvertMemoryMap(EFI_MEMORY_DESCRIPTOR* EfiMemoryMap, UINTN EfiMapSize, UINTN EfiDescSize, boot_info_t* boot_info)
+{
+    UINTN NumDescriptors;
+    UINTN i;
+    EFI_MEMORY_DESCRIPTOR* EfiDesc;
+    memory_descriptor_t* KernelDesc;
+    
+    if (!EfiMemoryMap || !boot_info) {
+        return EFI_INVALID_PARAMETER;
+    }
+    
+    NumDescriptors = EfiMapSize / EfiDescSize;
+    
+    if (NumDescriptors > MAX_MEMORY_DESCRIPTORS) {
+        return EFI_OUT_OF_RESOURCES;
+    }
+    
+    KernelDesc = static_memory_descriptors;
+    
+    EfiDesc = EfiMemoryMap;
+    for (i = 0; i < NumDescriptors; i++) {
+        switch (EfiDesc->Type) {
+            case EfiReservedMemoryType:
+                KernelDesc[i].type = MEMORY_TYPE_RESERVED;
+                break;
+            case EfiLoaderCode:
+                KernelDesc[i].type = MEMORY_TYPE_LOADER_CODE;
+                break;
+            case EfiLoaderData:
+                KernelDesc[i].type = MEMORY_TYPE_LOADER_DATA;
+                break;
+            case EfiBootServicesCode:
+                KernelDesc[i].type = MEMORY_TYPE_BOOT_CODE;
+                break;
+            case EfiBootServicesData:
+                KernelDesc[i].type = MEMORY_TYPE_BOOT_DATA;
+                break;
+            case EfiRuntimeServicesCode:
+                KernelDesc[i].type = MEMORY_TYPE_RUNTIME_CODE;
+                break;
+            case EfiRuntimeServicesData:
+                KernelDesc[i].type = MEMORY_TYPE_RUNTIME_DATA;
+                break;
+            case EfiConventionalMemory:
+                KernelDesc[i].type = MEMORY_TYPE_CONVENTIONAL;
+                break;
+            case EfiUnusableMemory:
+                KernelDesc[i].type = MEMORY_TYPE_UNUSABLE;
+                break;
+            case EfiACPIReclaimMemory:
+                KernelDesc[i].type = MEMORY_TYPE_ACPI_RECLAIM;
+                break;
+            case EfiACPIMemoryNVS:
+                KernelDesc[i].type = MEMORY_TYPE_ACPI_NVS;
+                break;
+            case EfiMemoryMappedIO:
+                KernelDesc[i].type = MEMORY_TYPE_MMIO;
+                break;
+            case EfiMemoryMappedIOPortSpace:
+                KernelDesc[i].type = MEMORY_TYPE_MMIO_PORT_SPACE;
+                break;
+            case EfiPalCode:
+                KernelDesc[i].type = MEMORY_TYPE_PAL_CODE;
+                break;
+            case EfiPersistentMemory:
+                KernelDesc[i].type = MEMORY_TYPE_PERSISTENT;
+                break;
+            default:
+                KernelDesc[i].type = MEMORY_TYPE_RESERVED;
+                break;
+        }
+        
+        KernelDesc[i].pad = 0;
+        KernelDesc[i].physical_start = EfiDesc->PhysicalStart;
+        KernelDesc[i].virtual_start = EfiDesc->VirtualStart;
+        KernelDesc[i].number_of_pages = EfiDesc->NumberOfPages;
+        KernelDesc[i].attribute = EfiDesc->Attribute;
+        
+        EfiDesc = (EFI_MEMORY_DESCRIPTOR*)((UINT8*)EfiDesc + EfiDescSize);
+    }
+    
+    boot_info->memory_map_base = KernelDesc;
+    boot_info->memory_map_size = NumDescriptors * sizeof(memory_descriptor_t);
+    boot_info->memory_map_desc_size = sizeof(memory_descriptor_t);
+    boot_info->memory_map_desc_count = NumDescriptors;
+    
+    return EFI_SUCCESS;
+}
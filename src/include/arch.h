@@ -0,0 +1,143 @@
+#ifndef RLOS_ARCH_H
+#define RLOS_ARCH_H
+
+#include "stdint.h"
+
+// AArch64 相关的底层操作，其余内核代码只通过这里访问系统寄存器。
+// 主机单元测试 (make test) 定义 RLOS_HOST，换用 tests/host/arch_host.h 中的模拟实现
+
+#ifdef RLOS_HOST
+#include "arch_host.h"
+#else
+
+static inline void mmio_write32(unsigned long addr, unsigned int value) {
+    *(volatile unsigned int*)addr = value;
+}
+
+static inline unsigned int mmio_read32(unsigned long addr) {
+    return *(volatile unsigned int*)addr;
+}
+
+static inline uint64_t mmio_read64(unsigned long addr) {
+    return *(volatile uint64_t*)addr;
+}
+
+static inline unsigned int arch_cpu_id(void) {
+    uint64_t id;
+    __asm__ volatile ("mrs %0, tpidr_el1" : "=r" (id));
+    return (unsigned int)id;
+}
+
+static inline void arch_set_cpu_id(unsigned int id) {
+    __asm__ volatile ("msr tpidr_el1, %0" :: "r" ((uint64_t)id) : "memory");
+}
+
+static inline uint64_t arch_read_mpidr(void) {
+    uint64_t mpidr;
+    __asm__ volatile ("mrs %0, mpidr_el1" : "=r" (mpidr));
+    return mpidr;
+}
+
+static inline unsigned int arch_current_el(void) {
+    uint64_t el;
+    __asm__ volatile ("mrs %0, CurrentEL" : "=r" (el));
+    return (unsigned int)((el >> 2) & 3);
+}
+
+static inline void cpu_relax(void) {
+    __asm__ volatile ("yield" ::: "memory");
+}
+
+static inline void arch_wfe(void) {
+    __asm__ volatile ("wfe" ::: "memory");
+}
+
+static inline void arch_sev(void) {
+    __asm__ volatile ("dsb ishst; sev" ::: "memory");
+}
+
+static inline uint64_t arch_counter_read(void) {
+    uint64_t cnt;
+    __asm__ volatile ("isb; mrs %0, cntvct_el0" : "=r" (cnt) :: "memory");
+    return cnt;
+}
+
+// 不带 isb，供追踪等只需要大致时序的场合
+static inline uint64_t arch_counter_read_relaxed(void) {
+    uint64_t cnt;
+    __asm__ volatile ("mrs %0, cntvct_el0" : "=r" (cnt));
+    return cnt;
+}
+
+static inline uint64_t arch_counter_freq(void) {
+    uint64_t freq;
+    __asm__ volatile ("mrs %0, cntfrq_el0" : "=r" (freq));
+    return freq;
+}
+
+// 虚拟定时器 CNTV：ENABLE=bit0, IMASK=bit1
+#define ARCH_TIMER_CTL_ENABLE  (1UL << 0)
+#define ARCH_TIMER_CTL_IMASK   (1UL << 1)
+
+static inline void arch_timer_set_cval(uint64_t cval) {
+    __asm__ volatile ("msr cntv_cval_el0, %0" :: "r" (cval));
+    __asm__ volatile ("msr cntv_ctl_el0, %0; isb" :: "r" (ARCH_TIMER_CTL_ENABLE) : "memory");
+}
+
+static inline void arch_timer_disable(void) {
+    __asm__ volatile ("msr cntv_ctl_el0, %0; isb" :: "r" (ARCH_TIMER_CTL_IMASK) : "memory");
+}
+
+static inline void arch_wfi(void) {
+    __asm__ volatile ("dsb sy; wfi" ::: "memory");
+}
+
+static inline void arch_local_irq_enable(void) {
+    __asm__ volatile ("msr daifclr, #2" ::: "memory");
+}
+
+static inline void arch_local_irq_disable(void) {
+    __asm__ volatile ("msr daifset, #2" ::: "memory");
+}
+
+static inline uint64_t arch_local_irq_save(void) {
+    uint64_t flags;
+    __asm__ volatile ("mrs %0, daif; msr daifset, #2" : "=r" (flags) :: "memory");
+    return flags;
+}
+
+static inline void arch_local_irq_restore(uint64_t flags) {
+    __asm__ volatile ("msr daif, %0" :: "r" (flags) : "memory");
+}
+
+// 清理到 PoC，供关闭 MMU 运行的从核读取
+static inline void arch_dcache_clean_range(const void* start, uint64_t size) {
+    uint64_t ctr;
+    __asm__ volatile ("mrs %0, ctr_el0" : "=r" (ctr));
+    uint64_t line = 4UL << ((ctr >> 16) & 0xF);
+    uint64_t addr = (uint64_t)start & ~(line - 1);
+    uint64_t end = (uint64_t)start + size;
+
+    for (; addr < end; addr += line) {
+        __asm__ volatile ("dc cvac, %0" :: "r" (addr) : "memory");
+    }
+    __asm__ volatile ("dsb sy" ::: "memory");
+}
+
+#define AARCH64_INSN_NOP  0xD503201Fu
+
+static inline uint32_t aarch64_insn_b(uint64_t pc, uint64_t target) {
+    return 0x14000000u | (uint32_t)(((target - pc) >> 2) & 0x03FFFFFF);
+}
+
+// 改写一条内核指令。IC IVAU 在内部共享域广播，
+// 其他 CPU 在下一次上下文同步事件（异常进入/返回）后看到新指令
+static inline void arch_patch_insn(uint32_t* addr, uint32_t insn) {
+    *(volatile uint32_t*)addr = insn;
+    __asm__ volatile ("dc cvau, %0; dsb ish; ic ivau, %0; dsb ish; isb"
+                      :: "r" (addr) : "memory");
+}
+
+#endif /* RLOS_HOST */
+
+#endif /* RLOS_ARCH_H */
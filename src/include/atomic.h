@@ -0,0 +1,23 @@
+#ifndef RLOS_ATOMIC_H
+#define RLOS_ATOMIC_H
+
+#include "compiler.h"
+
+// 基于 GCC __atomic 内建函数，内核需以 -mno-outline-atomics 编译（无 libgcc）
+
+#define READ_ONCE(x)              __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define WRITE_ONCE(x, val)        __atomic_store_n(&(x), (val), __ATOMIC_RELAXED)
+
+#define smp_load_acquire(p)       __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define smp_store_release(p, val) __atomic_store_n((p), (val), __ATOMIC_RELEASE)
+
+#define smp_mb()                  __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define smp_rmb()                 __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define smp_wmb()                 __atomic_thread_fence(__ATOMIC_RELEASE)
+
+#define atomic_fetch_add(p, val)  __atomic_fetch_add((p), (val), __ATOMIC_ACQ_REL)
+#define atomic_fetch_sub(p, val)  __atomic_fetch_sub((p), (val), __ATOMIC_ACQ_REL)
+#define atomic_fetch_or(p, val)   __atomic_fetch_or((p), (val), __ATOMIC_ACQ_REL)
+#define atomic_fetch_and(p, val)  __atomic_fetch_and((p), (val), __ATOMIC_ACQ_REL)
+
+#endif /* RLOS_ATOMIC_H */
@@ -0,0 +1,10 @@
+#ifndef RLOS_BENCH_H
+#define RLOS_BENCH_H
+
+// 内核内基准测试，仅在 make BENCH=1 时编译调用。
+// 结果行统一以 "BENCH " 开头，便于从串口日志中提取
+
+void rcu_bench_run(void);
+void timer_bench_run(void);
+
+#endif /* RLOS_BENCH_H */
@@ -0,0 +1,31 @@
+#ifndef RLOS_COMPILER_H
+#define RLOS_COMPILER_H
+
+#include "stdint.h"
+
+#ifndef NULL
+#define NULL ((void*)0)
+#endif
+
+#ifndef offsetof
+#define offsetof(type, member) __builtin_offsetof(type, member)
+#endif
+
+#define container_of(ptr, type, member) \
+    ((type*)((char*)(ptr) - offsetof(type, member)))
+
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+#define likely(x)     __builtin_expect(!!(x), 1)
+#define unlikely(x)   __builtin_expect(!!(x), 0)
+
+#define barrier()     __asm__ volatile("" ::: "memory")
+
+#define CACHELINE_SIZE       64
+#define __aligned(n)         __attribute__((aligned(n)))
+#define __cacheline_aligned  __aligned(CACHELINE_SIZE)
+#define __noreturn           __attribute__((noreturn))
+// 不被 TRACE=1 的 -finstrument-functions 插桩
+#define __notrace            __attribute__((no_instrument_function))
+
+#endif /* RLOS_COMPILER_H */
@@ -0,0 +1,40 @@
+#ifndef RLOS_HASHTABLE_H
+#define RLOS_HASHTABLE_H
+
+#include "rculist.h"
+
+// 定长哈希表，桶数必须是 2 的幂：
+//   static struct hlist_head table[1 << 10];
+// 零初始化即为空表
+
+#define HASH_SIZE(table) ARRAY_SIZE(table)
+#define HASH_BITS(table) ((unsigned int)__builtin_ctzll(HASH_SIZE(table)))
+
+#define GOLDEN_RATIO_64 0x61C8864680B583EBull
+
+static inline uint64_t hash_64(uint64_t val, unsigned int bits) {
+    return bits ? (val * GOLDEN_RATIO_64) >> (64 - bits) : 0;
+}
+
+static inline void __hash_init(struct hlist_head* table, uint64_t size) {
+    for (uint64_t i = 0; i < size; i++) {
+        INIT_HLIST_HEAD(&table[i]);
+    }
+}
+
+#define hash_init(table) __hash_init(table, HASH_SIZE(table))
+
+#define hash_bucket(table, key) (&(table)[hash_64((key), HASH_BITS(table))])
+
+#define hash_add(table, node, key)      hlist_add_head(node, hash_bucket(table, key))
+#define hash_add_rcu(table, node, key)  hlist_add_head_rcu(node, hash_bucket(table, key))
+#define hash_del(node)                  hlist_del_init(node)
+#define hash_del_rcu(node)              hlist_del_init_rcu(node)
+
+#define hash_for_each_possible(table, obj, member, key) \
+    hlist_for_each_entry(obj, hash_bucket(table, key), member)
+
+#define hash_for_each_possible_rcu(table, obj, member, key) \
+    hlist_for_each_entry_rcu(obj, hash_bucket(table, key), member)
+
+#endif /* RLOS_HASHTABLE_H */
@@ -0,0 +1,33 @@
+#ifndef RLOS_IRQ_H
+#define RLOS_IRQ_H
+
+#include "stdint.h"
+
+// GICv3 (QEMU virt, gic-version=3)
+#define GICD_BASE          0x08000000UL
+#define GICR_BASE          0x080A0000UL
+
+#define IRQ_MAX            1020
+#define IRQ_PPI_VTIMER     27
+
+// 布局与 vectors.S 保持一致
+struct pt_regs {
+    uint64_t regs[31];
+    uint64_t elr;
+    uint64_t spsr;
+    uint64_t pad;
+};
+
+typedef void (*irq_handler_t)(uint32_t intid);
+
+void irq_init(void);
+void irq_cpu_init(void);
+
+int irq_register(uint32_t intid, irq_handler_t handler);
+void irq_enable(uint32_t intid);
+void irq_disable(uint32_t intid);
+
+void irq_handle(struct pt_regs* regs);
+void exception_bad(struct pt_regs* regs, uint64_t type);
+
+#endif /* RLOS_IRQ_H */
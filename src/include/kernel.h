@@ -5,4 +5,10 @@
 
 void kernel_main(boot_info_t* boot_info);
 
-#endif
\ No newline at end of file
+void uart_init(void);
+void uart_putc(char c);
+void uart_puts(const char* str);
+void uart_put_hex(unsigned long value);
+void uart_put_dec(unsigned long value);
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef RLOS_KTIME_H
+#define RLOS_KTIME_H
+
+#include "stdint.h"
+
+#define NSEC_PER_USEC  1000ULL
+#define NSEC_PER_MSEC  1000000ULL
+#define NSEC_PER_SEC   1000000000ULL
+
+// 以 CNTVCT/CNTFRQ 为时钟源的单调纳秒时间（自计数器归零起）。
+// 换算用预先计算的 mult/shift 和 128 位乘法，不做除法
+
+struct clocksource {
+    uint64_t freq;
+    uint64_t cyc2ns_mult;      // ns = (cyc * cyc2ns_mult) >> 32
+    uint64_t ns2cyc_mult;      // cyc = (ns * ns2cyc_mult) >> 32
+};
+
+extern struct clocksource clocksource;
+
+void clocksource_init(void);
+
+static inline uint64_t clocksource_cyc2ns(uint64_t cyc) {
+    return (uint64_t)(((unsigned __int128)cyc * clocksource.cyc2ns_mult) >> 32);
+}
+
+// 向上取整，保证按此换算出的比较值不会早于给定时刻
+static inline uint64_t clocksource_ns2cyc(uint64_t ns) {
+    return (uint64_t)(((unsigned __int128)ns * clocksource.ns2cyc_mult) >> 32) + 1;
+}
+
+uint64_t ktime_get_ns(void);
+void ndelay(uint64_t ns);
+
+static inline void udelay(uint64_t us) {
+    ndelay(us * NSEC_PER_USEC);
+}
+
+static inline void mdelay(uint64_t ms) {
+    ndelay(ms * NSEC_PER_MSEC);
+}
+
+#endif /* RLOS_KTIME_H */
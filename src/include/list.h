@@ -0,0 +1,140 @@
+#ifndef RLOS_LIST_H
+#define RLOS_LIST_H
+
+#include "compiler.h"
+#include "atomic.h"
+
+// 侵入式双向链表。内核按 0 地址链接且不做重定位，
+// 因此不提供静态初始化宏，链表头需在运行时用 INIT_LIST_HEAD 初始化
+
+struct list_head {
+    struct list_head* next;
+    struct list_head* prev;
+};
+
+static inline void INIT_LIST_HEAD(struct list_head* list) {
+    WRITE_ONCE(list->next, list);
+    list->prev = list;
+}
+
+static inline void __list_add(struct list_head* entry, struct list_head* prev, struct list_head* next) {
+    next->prev = entry;
+    entry->next = next;
+    entry->prev = prev;
+    WRITE_ONCE(prev->next, entry);
+}
+
+static inline void list_add(struct list_head* entry, struct list_head* head) {
+    __list_add(entry, head, head->next);
+}
+
+static inline void list_add_tail(struct list_head* entry, struct list_head* head) {
+    __list_add(entry, head->prev, head);
+}
+
+static inline void __list_del(struct list_head* prev, struct list_head* next) {
+    next->prev = prev;
+    WRITE_ONCE(prev->next, next);
+}
+
+static inline void list_del(struct list_head* entry) {
+    __list_del(entry->prev, entry->next);
+    entry->next = NULL;
+    entry->prev = NULL;
+}
+
+static inline void list_del_init(struct list_head* entry) {
+    __list_del(entry->prev, entry->next);
+    INIT_LIST_HEAD(entry);
+}
+
+static inline int list_empty(const struct list_head* head) {
+    return READ_ONCE(head->next) == head;
+}
+
+#define list_entry(ptr, type, member) container_of(ptr, type, member)
+
+#define list_first_entry(head, type, member) list_entry((head)->next, type, member)
+
+#define list_next_entry(pos, member) \
+    list_entry((pos)->member.next, __typeof__(*(pos)), member)
+
+#define list_for_each_entry(pos, head, member)                   \
+    for (pos = list_first_entry(head, __typeof__(*pos), member); \
+         &pos->member != (head);                                 \
+         pos = list_next_entry(pos, member))
+
+#define list_for_each_entry_safe(pos, tmp, head, member)          \
+    for (pos = list_first_entry(head, __typeof__(*pos), member),  \
+         tmp = list_next_entry(pos, member);                      \
+         &pos->member != (head);                                  \
+         pos = tmp, tmp = list_next_entry(tmp, member))
+
+// 单指针表头的哈希链表，零初始化即为空表
+struct hlist_node {
+    struct hlist_node* next;
+    struct hlist_node** pprev;
+};
+
+struct hlist_head {
+    struct hlist_node* first;
+};
+
+static inline void INIT_HLIST_HEAD(struct hlist_head* head) {
+    head->first = NULL;
+}
+
+static inline void INIT_HLIST_NODE(struct hlist_node* node) {
+    node->next = NULL;
+    node->pprev = NULL;
+}
+
+static inline int hlist_unhashed(const struct hlist_node* node) {
+    return !node->pprev;
+}
+
+static inline int hlist_empty(const struct hlist_head* head) {
+    return !READ_ONCE(head->first);
+}
+
+static inline void hlist_add_head(struct hlist_node* node, struct hlist_head* head) {
+    struct hlist_node* first = head->first;
+
+    node->next = first;
+    if (first) {
+        first->pprev = &node->next;
+    }
+    WRITE_ONCE(head->first, node);
+    node->pprev = &head->first;
+}
+
+static inline void __hlist_del(struct hlist_node* node) {
+    struct hlist_node* next = node->next;
+    struct hlist_node** pprev = node->pprev;
+
+    WRITE_ONCE(*pprev, next);
+    if (next) {
+        next->pprev = pprev;
+    }
+}
+
+static inline void hlist_del_init(struct hlist_node* node) {
+    if (!hlist_unhashed(node)) {
+        __hlist_del(node);
+        INIT_HLIST_NODE(node);
+    }
+}
+
+#define hlist_entry(ptr, type, member) container_of(ptr, type, member)
+
+#define hlist_entry_safe(ptr, type, member) ({             \
+    __typeof__(ptr) ____ptr = (ptr);                        \
+    ____ptr ? hlist_entry(____ptr, type, member) : NULL;    \
+})
+
+#define hlist_for_each_entry(pos, head, member)                                  \
+    for (pos = hlist_entry_safe((head)->first, __typeof__(*(pos)), member);      \
+         pos;                                                                    \
+         pos = hlist_entry_safe((pos)->member.next, __typeof__(*(pos)), member))
+
+#endif /* RLOS_LIST_H */
@@ -0,0 +1,46 @@
+#ifndef RLOS_RCU_H
+#define RLOS_RCU_H
+
+#include "compiler.h"
+#include "atomic.h"
+
+// 基于静止状态 (QSBR) 的 RCU：
+//   - 读者等待无关，rcu_read_lock/unlock 只是编译屏障
+//   - 上下文切换和 idle 是静止状态，由调度器/idle 循环通知
+//   - call_rcu 回调挂在每 CPU 队列上，宽限期结束后分批执行
+// 读侧临界区内不得调用 rcu_note_context_switch、rcu_idle_enter 或 synchronize_rcu
+
+struct rcu_head {
+    struct rcu_head* next;
+    void (*func)(struct rcu_head* head);
+};
+
+typedef void (*rcu_callback_t)(struct rcu_head* head);
+
+static inline void rcu_read_lock(void) {
+    barrier();
+}
+
+static inline void rcu_read_unlock(void) {
+    barrier();
+}
+
+// AArch64 保证地址依赖的读序，读者只需一次普通加载
+#define rcu_dereference(p)         READ_ONCE(p)
+#define rcu_assign_pointer(p, v)   smp_store_release(&(p), (v))
+#define RCU_INIT_POINTER(p, v)     WRITE_ONCE(p, v)
+
+void rcu_init(void);
+void rcu_cpu_online(unsigned int cpu);
+
+void rcu_note_context_switch(void);
+void rcu_idle_enter(void);
+void rcu_idle_exit(void);
+void rcu_irq_enter(void);
+void rcu_irq_exit(void);
+void rcu_check_callbacks(void);
+
+void call_rcu(struct rcu_head* head, rcu_callback_t func);
+void synchronize_rcu(void);
+
+#endif /* RLOS_RCU_H */
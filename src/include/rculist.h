@@ -0,0 +1,74 @@
+#ifndef RLOS_RCULIST_H
+#define RLOS_RCULIST_H
+
+#include "list.h"
+#include "rcu.h"
+
+// RCU 保护的链表：更新者之间需自行加锁互斥，读者只需 rcu_read_lock。
+// 删除后的节点要等一个宽限期 (call_rcu/synchronize_rcu) 才能复用
+
+static inline void __list_add_rcu(struct list_head* entry, struct list_head* prev, struct list_head* next) {
+    entry->next = next;
+    entry->prev = prev;
+    rcu_assign_pointer(prev->next, entry);
+    next->prev = entry;
+}
+
+static inline void list_add_rcu(struct list_head* entry, struct list_head* head) {
+    __list_add_rcu(entry, head, head->next);
+}
+
+static inline void list_add_tail_rcu(struct list_head* entry, struct list_head* head) {
+    __list_add_rcu(entry, head->prev, head);
+}
+
+// 保留 entry->next，正在遍历该节点的读者仍能继续前进
+static inline void list_del_rcu(struct list_head* entry) {
+    __list_del(entry->prev, entry->next);
+    entry->prev = NULL;
+}
+
+static inline void list_replace_rcu(struct list_head* old, struct list_head* entry) {
+    entry->next = old->next;
+    entry->prev = old->prev;
+    rcu_assign_pointer(entry->prev->next, entry);
+    entry->next->prev = entry;
+    old->prev = NULL;
+}
+
+#define list_entry_rcu(ptr, type, member) container_of(rcu_dereference(ptr), type, member)
+
+#define list_for_each_entry_rcu(pos, head, member)                                 \
+    for (pos = list_entry_rcu((head)->next, __typeof__(*pos), member);             \
+         &pos->member != (head);                                                   \
+         pos = list_entry_rcu(pos->member.next, __typeof__(*pos), member))
+
+static inline void hlist_add_head_rcu(struct hlist_node* node, struct hlist_head* head) {
+    struct hlist_node* first = head->first;
+
+    node->next = first;
+    node->pprev = &head->first;
+    rcu_assign_pointer(head->first, node);
+    if (first) {
+        first->pprev = &node->next;
+    }
+}
+
+static inline void hlist_del_rcu(struct hlist_node* node) {
+    __hlist_del(node);
+    node->pprev = NULL;
+}
+
+static inline void hlist_del_init_rcu(struct hlist_node* node) {
+    if (!hlist_unhashed(node)) {
+        __hlist_del(node);
+        node->pprev = NULL;
+    }
+}
+
+#define hlist_for_each_entry_rcu(pos, head, member)                                          \
+    for (pos = hlist_entry_safe(rcu_dereference((head)->first), __typeof__(*(pos)), member); \
+         pos;                                                                                \
+         pos = hlist_entry_safe(rcu_dereference((pos)->member.next), __typeof__(*(pos)), member))
+
+#endif /* RLOS_RCULIST_H */
@@ -0,0 +1,32 @@
+#ifndef RLOS_SMP_H
+#define RLOS_SMP_H
+
+#include "arch.h"
+#include "atomic.h"
+
+#define NR_CPUS 8
+
+typedef void (*smp_call_func_t)(void* arg);
+
+extern uint64_t cpu_online_mask;
+
+static inline unsigned int smp_processor_id(void) {
+    return arch_cpu_id();
+}
+
+static inline int cpu_online(unsigned int cpu) {
+    return (READ_ONCE(cpu_online_mask) >> cpu) & 1;
+}
+
+static inline unsigned int num_online_cpus(void) {
+    return (unsigned int)__builtin_popcountll(READ_ONCE(cpu_online_mask));
+}
+
+void smp_boot_cpu_init(void);
+void smp_init(void);
+
+// 让空闲的从核执行 func(arg)，返回 0 表示已投递
+int smp_call_on(unsigned int cpu, smp_call_func_t func, void* arg);
+void smp_call_wait(unsigned int cpu);
+
+#endif /* RLOS_SMP_H */
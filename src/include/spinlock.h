@@ -0,0 +1,85 @@
+#ifndef RLOS_SPINLOCK_H
+#define RLOS_SPINLOCK_H
+
+#include "arch.h"
+#include "atomic.h"
+
+// 票据自旋锁，零初始化即为未加锁状态
+typedef struct {
+    uint32_t next;
+    uint32_t owner;
+} spinlock_t;
+
+static inline void spin_lock_init(spinlock_t* lock) {
+    lock->next = 0;
+    lock->owner = 0;
+}
+
+static inline void spin_lock(spinlock_t* lock) {
+    uint32_t ticket = __atomic_fetch_add(&lock->next, 1, __ATOMIC_RELAXED);
+
+    while (smp_load_acquire(&lock->owner) != ticket) {
+        cpu_relax();
+    }
+}
+
+static inline void spin_unlock(spinlock_t* lock) {
+    smp_store_release(&lock->owner, lock->owner + 1);
+}
+
+static inline uint64_t spin_lock_irqsave(spinlock_t* lock) {
+    uint64_t flags = arch_local_irq_save();
+    spin_lock(lock);
+    return flags;
+}
+
+static inline void spin_unlock_irqrestore(spinlock_t* lock, uint64_t flags) {
+    spin_unlock(lock);
+    arch_local_irq_restore(flags);
+}
+
+// 读写锁：低 31 位为读者计数，最高位为写者
+#define RWLOCK_WRITER 0x80000000u
+
+typedef struct {
+    uint32_t cnt;
+} rwlock_t;
+
+static inline void rwlock_init(rwlock_t* lock) {
+    lock->cnt = 0;
+}
+
+static inline void read_lock(rwlock_t* lock) {
+    for (;;) {
+        uint32_t cnt = READ_ONCE(lock->cnt);
+
+        if (!(cnt & RWLOCK_WRITER) &&
+            __atomic_compare_exchange_n(&lock->cnt, &cnt, cnt + 1, 1,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            return;
+        }
+        cpu_relax();
+    }
+}
+
+static inline void read_unlock(rwlock_t* lock) {
+    __atomic_fetch_sub(&lock->cnt, 1, __ATOMIC_RELEASE);
+}
+
+static inline void write_lock(rwlock_t* lock) {
+    for (;;) {
+        uint32_t cnt = 0;
+
+        if (__atomic_compare_exchange_n(&lock->cnt, &cnt, RWLOCK_WRITER, 1,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            return;
+        }
+        cpu_relax();
+    }
+}
+
+static inline void write_unlock(rwlock_t* lock) {
+    smp_store_release(&lock->cnt, 0);
+}
+
+#endif /* RLOS_SPINLOCK_H */
@@ -0,0 +1,56 @@
+#ifndef RLOS_STATIC_KEY_H
+#define RLOS_STATIC_KEY_H
+
+#include "compiler.h"
+
+// 静态分支：关闭时分支点是一条 nop，打开时由 static_key_enable
+// 把所有引用该 key 的 nop 改写为跳转。__jump_table 中只存相对偏移，
+// 内核按 0 地址链接、加载到任意物理地址也能正确解析
+
+struct static_key {
+    uint32_t enabled;
+};
+
+struct jump_entry {
+    int32_t code;
+    int32_t target;
+    int64_t key;
+};
+
+#ifdef RLOS_HOST
+// 主机测试无法改写代码段，退化为普通的标志判断
+static inline int static_branch_unlikely(struct static_key* key) {
+    return unlikely(__atomic_load_n(&key->enabled, __ATOMIC_RELAXED));
+}
+
+static inline void static_key_enable(struct static_key* key) {
+    __atomic_store_n(&key->enabled, 1, __ATOMIC_RELAXED);
+}
+
+static inline void static_key_disable(struct static_key* key) {
+    __atomic_store_n(&key->enabled, 0, __ATOMIC_RELAXED);
+}
+#else
+// key 以 "i" 操作数传给汇编，需要 -fno-pie（见 Makefile KERNEL_CFLAGS）
+static inline __attribute__((always_inline)) int static_branch_unlikely(struct static_key* key) {
+    __asm__ goto ("1: nop\n\t"
+                  ".pushsection __jump_table, \"aw\"\n\t"
+                  ".balign 8\n\t"
+                  ".long 1b - ., %l[l_yes] - .\n\t"
+                  ".quad %c0 - .\n\t"
+                  ".popsection"
+                  :: "i" (key) :: l_yes);
+    return 0;
+l_yes:
+    return 1;
+}
+
+void static_key_enable(struct static_key* key);
+void static_key_disable(struct static_key* key);
+#endif /* RLOS_HOST */
+
+static inline int static_key_enabled(const struct static_key* key) {
+    return __atomic_load_n(&key->enabled, __ATOMIC_RELAXED);
+}
+
+#endif /* RLOS_STATIC_KEY_H */
@@ -0,0 +1,28 @@
+#ifndef RLOS_STRING_H
+#define RLOS_STRING_H
+
+#include "stdint.h"
+
+// 内核自带的字符串/内存函数；-ffreestanding 下 GCC 仍可能生成对
+// memset/memcpy 的调用，因此必须提供这些符号
+
+#ifdef RLOS_HOST
+// 主机测试时与 libc 的同名函数区分开
+#define memset   rlos_memset
+#define memcpy   rlos_memcpy
+#define memmove  rlos_memmove
+#define memcmp   rlos_memcmp
+#define strlen   rlos_strlen
+#define strcmp   rlos_strcmp
+#define strncmp  rlos_strncmp
+#endif
+
+void* memset(void* dst, int c, size_t n);
+void* memcpy(void* dst, const void* src, size_t n);
+void* memmove(void* dst, const void* src, size_t n);
+int memcmp(const void* a, const void* b, size_t n);
+size_t strlen(const char* str);
+int strcmp(const char* a, const char* b);
+int strncmp(const char* a, const char* b, size_t n);
+
+#endif /* RLOS_STRING_H */
@@ -0,0 +1,50 @@
+#ifndef RLOS_TIMER_H
+#define RLOS_TIMER_H
+
+#include "list.h"
+#include "ktime.h"
+
+// 每 CPU 定时器：
+//   - 层级时间轮（节拍 TIMER_TICK_NS）承载大部分超时，插入/取消 O(1)
+//   - 不足一个节拍的截止时间进入小型最小堆，按纳秒精度触发
+// 两者共用 CNTV 比较器，以 one-shot 方式编程到最近的事件。
+// 定时器总是挂在调用 timer_start 的 CPU 上，回调在该 CPU 的中断上下文执行
+
+#define TIMER_HZ           1000
+#define TIMER_TICK_NS      (NSEC_PER_SEC / TIMER_HZ)
+#define HRTIMER_HEAP_SIZE  256
+
+enum {
+    TIMER_IDLE,
+    TIMER_WHEEL,
+    TIMER_HEAP,
+};
+
+struct timer;
+typedef void (*timer_func_t)(struct timer* timer);
+
+struct timer {
+    struct list_head entry;
+    uint64_t expires;           // 绝对时间 (ktime ns)
+    timer_func_t func;
+    uint32_t heap_index;
+    uint8_t state;
+    uint8_t cpu;
+    uint16_t slot;              // 所在时间轮槽号，仅 TIMER_WHEEL 时有效
+};
+
+void timers_init(void);
+void timer_cpu_init(void);
+
+void timer_init(struct timer* timer, timer_func_t func);
+void timer_start(struct timer* timer, uint64_t expires);
+int timer_cancel(struct timer* timer);
+
+static inline int timer_pending(const struct timer* timer) {
+    return READ_ONCE(timer->state) != TIMER_IDLE;
+}
+
+// 需开中断；没有调度器时以 wfi 等待
+void timer_sleep_ns(uint64_t ns);
+
+#endif /* RLOS_TIMER_H */
@@ -0,0 +1,61 @@
+#ifndef RLOS_TRACE_H
+#define RLOS_TRACE_H
+
+#include "static_key.h"
+
+// 静态追踪点：写入每 CPU 二进制环形缓冲，时间戳为 CNTVCT。
+// 关闭时每个追踪点只剩一条 nop。串口导出格式见 trace_dump，
+// 主机端用 tools/trace2json.py 转成 Chrome/Perfetto JSON。
+// 事件编号与 tools/trace2json.py 中的表保持一致
+
+enum {
+    TRACE_PH_INSTANT = 0,
+    TRACE_PH_BEGIN   = 1,
+    TRACE_PH_END     = 2,
+};
+
+enum {
+    TRACE_IRQ            = 1,   // arg0: intid
+    TRACE_TIMER_EXPIRE   = 2,   // arg1: expires, arg2: 实际触发时刻 (ns)
+    TRACE_WAKEUP         = 3,   // arg1: 被唤醒的等待者
+    TRACE_RCU_GP_START   = 4,   // arg1: gp_seq
+    TRACE_RCU_GP_END     = 5,   // arg1: gp_seq
+    TRACE_RCU_CALLBACKS  = 6,   // arg0: 本批执行的回调数
+    TRACE_SMP_CALL       = 7,   // arg1: 函数偏移
+    TRACE_IDLE           = 8,
+    TRACE_FUNC           = 9,   // arg1: 函数偏移, arg2: 调用点偏移
+};
+
+struct trace_entry {
+    uint64_t ts;
+    uint16_t id;
+    uint8_t cpu;
+    uint8_t phase;
+    uint32_t arg0;
+    uint64_t arg1;
+    uint64_t arg2;
+};
+
+extern struct static_key trace_key;
+
+void __trace_record(uint16_t id, uint8_t phase, uint32_t arg0, uint64_t arg1, uint64_t arg2);
+
+#define trace_event(id, phase, arg0, arg1, arg2)                  \
+    do {                                                          \
+        if (static_branch_unlikely(&trace_key)) {                 \
+            __trace_record((id), (phase), (arg0), (arg1), (arg2));\
+        }                                                         \
+    } while (0)
+
+#define trace_begin(id, arg0, arg1, arg2)   trace_event(id, TRACE_PH_BEGIN, arg0, arg1, arg2)
+#define trace_end(id, arg0, arg1, arg2)     trace_event(id, TRACE_PH_END, arg0, arg1, arg2)
+#define trace_instant(id, arg0, arg1, arg2) trace_event(id, TRACE_PH_INSTANT, arg0, arg1, arg2)
+
+// 代码地址转为相对 _stext 的偏移，即 kernel.elf 中的链接地址
+uint64_t trace_text_offset(const void* addr);
+
+void trace_start(void);
+void trace_stop(void);
+void trace_dump(void);
+
+#endif /* RLOS_TRACE_H */
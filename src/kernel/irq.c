@@ -0,0 +1,188 @@
+#include "kernel.h"
+#include "irq.h"
+#include "smp.h"
+#include "rcu.h"
+#include "trace.h"
+
+#define GICD_CTLR            0x0000
+#define GICD_CTLR_RWP        (1u << 31)
+#define GICD_CTLR_ARE_NS     (1u << 4)
+#define GICD_CTLR_ENABLE_G1A (1u << 1)
+#define GICD_CTLR_ENABLE_G1  (1u << 0)
+
+#define GICR_STRIDE          0x20000
+#define GICR_CTLR            0x0000
+#define GICR_CTLR_RWP        (1u << 3)
+#define GICR_TYPER           0x0008
+#define GICR_TYPER_LAST      (1u << 4)
+#define GICR_WAKER           0x0014
+#define GICR_WAKER_SLEEP     (1u << 1)
+#define GICR_WAKER_ASLEEP    (1u << 2)
+
+#define GICR_SGI_BASE        0x10000
+#define GICR_IGROUPR0        (GICR_SGI_BASE + 0x0080)
+#define GICR_ISENABLER0      (GICR_SGI_BASE + 0x0100)
+#define GICR_ICENABLER0      (GICR_SGI_BASE + 0x0180)
+#define GICR_IPRIORITYR0     (GICR_SGI_BASE + 0x0400)
+
+#define GIC_PRIO_DEFAULT     0xA0
+#define GIC_SPURIOUS         1020
+
+// ICC_* 用编码形式，不依赖汇编器对 GICv3 寄存器名的支持
+#define ICC_SRE_EL1          "s3_0_c12_c12_5"
+#define ICC_PMR_EL1          "s3_0_c4_c6_0"
+#define ICC_BPR1_EL1         "s3_0_c12_c12_3"
+#define ICC_IGRPEN1_EL1      "s3_0_c12_c12_7"
+#define ICC_IAR1_EL1         "s3_0_c12_c12_0"
+#define ICC_EOIR1_EL1        "s3_0_c12_c12_1"
+
+static irq_handler_t irq_handlers[IRQ_MAX];
+static unsigned long gicr_bases[NR_CPUS];
+static uint64_t irq_spurious;
+
+extern char exception_vectors[];
+extern void arch_use_sp_elx(void);
+
+static void gicd_wait_rwp(void) {
+    while (mmio_read32(GICD_BASE + GICD_CTLR) & GICD_CTLR_RWP) {
+        cpu_relax();
+    }
+}
+
+static void gicr_wait_rwp(unsigned long rd) {
+    while (mmio_read32(rd + GICR_CTLR) & GICR_CTLR_RWP) {
+        cpu_relax();
+    }
+}
+
+// 通过 GICR_TYPER 中的亲和值找到本核的 redistributor
+static unsigned long gicr_find(void) {
+    uint64_t mpidr = arch_read_mpidr();
+    uint64_t aff = ((mpidr >> 8) & 0xFF000000ULL) | (mpidr & 0xFFFFFFULL);
+    unsigned long rd = GICR_BASE;
+
+    for (;;) {
+        uint64_t typer = mmio_read64(rd + GICR_TYPER);
+
+        if ((typer >> 32) == aff) {
+            return rd;
+        }
+        if (typer & GICR_TYPER_LAST) {
+            return 0;
+        }
+        rd += GICR_STRIDE;
+    }
+}
+
+void irq_init(void) {
+    mmio_write32(GICD_BASE + GICD_CTLR, 0);
+    gicd_wait_rwp();
+    mmio_write32(GICD_BASE + GICD_CTLR, GICD_CTLR_ARE_NS | GICD_CTLR_ENABLE_G1A | GICD_CTLR_ENABLE_G1);
+    gicd_wait_rwp();
+}
+
+void irq_cpu_init(void) {
+    unsigned int cpu = smp_processor_id();
+    unsigned long rd = gicr_find();
+
+    arch_use_sp_elx();
+    __asm__ volatile ("msr vbar_el1, %0; isb" :: "r" ((uint64_t)exception_vectors) : "memory");
+
+    gicr_bases[cpu] = rd;
+    if (!rd) {
+        uart_puts("  IRQ: redistributor not found\n");
+        return;
+    }
+
+    uint32_t waker = mmio_read32(rd + GICR_WAKER);
+    mmio_write32(rd + GICR_WAKER, waker & ~GICR_WAKER_SLEEP);
+    while (mmio_read32(rd + GICR_WAKER) & GICR_WAKER_ASLEEP) {
+        cpu_relax();
+    }
+
+    // 关闭固件遗留的 SGI/PPI，全部归入 Group 1
+    mmio_write32(rd + GICR_ICENABLER0, 0xFFFFFFFF);
+    gicr_wait_rwp(rd);
+    mmio_write32(rd + GICR_IGROUPR0, 0xFFFFFFFF);
+    for (uint32_t i = 0; i < 32; i += 4) {
+        mmio_write32(rd + GICR_IPRIORITYR0 + i, GIC_PRIO_DEFAULT * 0x01010101u);
+    }
+
+    uint64_t sre;
+    __asm__ volatile ("mrs %0, " ICC_SRE_EL1 : "=r" (sre));
+    __asm__ volatile ("msr " ICC_SRE_EL1 ", %0; isb" :: "r" (sre | 1) : "memory");
+    __asm__ volatile ("msr " ICC_PMR_EL1 ", %0" :: "r" (0xFFUL));
+    __asm__ volatile ("msr " ICC_BPR1_EL1 ", %0" :: "r" (0UL));
+    __asm__ volatile ("msr " ICC_IGRPEN1_EL1 ", %0; isb" :: "r" (1UL) : "memory");
+}
+
+int irq_register(uint32_t intid, irq_handler_t handler) {
+    if (intid >= IRQ_MAX) {
+        return -1;
+    }
+    irq_handlers[intid] = handler;
+    return 0;
+}
+
+// 目前只支持 SGI/PPI（本核 redistributor）
+void irq_enable(uint32_t intid) {
+    unsigned long rd = gicr_bases[smp_processor_id()];
+
+    if (rd && intid < 32) {
+        mmio_write32(rd + GICR_ISENABLER0, 1u << intid);
+    }
+}
+
+void irq_disable(uint32_t intid) {
+    unsigned long rd = gicr_bases[smp_processor_id()];
+
+    if (rd && intid < 32) {
+        mmio_write32(rd + GICR_ICENABLER0, 1u << intid);
+        gicr_wait_rwp(rd);
+    }
+}
+
+void irq_handle(struct pt_regs* regs) {
+    (void)regs;
+
+    rcu_irq_enter();
+    for (;;) {
+        uint64_t iar;
+        __asm__ volatile ("mrs %0, " ICC_IAR1_EL1 : "=r" (iar) :: "memory");
+
+        uint32_t intid = (uint32_t)(iar & 0xFFFFFF);
+        if (intid >= GIC_SPURIOUS) {
+            break;
+        }
+
+        trace_begin(TRACE_IRQ, intid, 0, 0);
+        if (irq_handlers[intid]) {
+            irq_handlers[intid](intid);
+        } else {
+            irq_spurious++;
+        }
+        trace_end(TRACE_IRQ, intid, 0, 0);
+
+        __asm__ volatile ("msr " ICC_EOIR1_EL1 ", %0; isb" :: "r" (iar) : "memory");
+    }
+    rcu_irq_exit();
+}
+
+void exception_bad(struct pt_regs* regs, uint64_t type) {
+    uint64_t esr, far;
+
+    __asm__ volatile ("mrs %0, esr_el1" : "=r" (esr));
+    __asm__ volatile ("mrs %0, far_el1" : "=r" (far));
+
+    uart_puts("\n*** Unhandled exception, type ");
+    uart_put_dec(type);
+    uart_puts(" on CPU ");
+    uart_put_dec(smp_processor_id());
+    uart_puts("\n  ESR: ");
+    uart_put_hex(esr);
+    uart_puts("\n  ELR: ");
+    uart_put_hex(regs->elr);
+    uart_puts("\n  FAR: ");
+    uart_put_hex(far);
+    uart_puts("\n");
+}
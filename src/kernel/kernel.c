@@ -1,5 +1,13 @@
 #include "kernel.h"
 #include "boot_info.h"
+#include "arch.h"
+#include "smp.h"
+#include "rcu.h"
+#include "irq.h"
+#include "ktime.h"
+#include "timer.h"
+#include "trace.h"
+#include "bench.h"
 
 #define UART0_BASE    0x09000000
 #define UART0_DR      (UART0_BASE + 0x00)
@@ -11,14 +19,6 @@
 
 #define UART_FR_TXFF  (1 << 5)
 
-static inline void mmio_write32(unsigned long addr, unsigned int value) {
-    *(volatile unsigned int*)addr = value;
-}
-
-static inline unsigned int mmio_read32(unsigned long addr) {
-    return *(volatile unsigned int*)addr;
-}
-
 void uart_init(void) {
     mmio_write32(UART0_CR, 0);
     
@@ -36,44 +36,8 @@ void uart_putc(char c) {
     mmio_write32(UART0_DR, c);
 }
 
-void uart_puts(const char* str) {
-    while (*str) {
-        if (*str == '\n') {
-            uart_putc('\r');
-        }
-        uart_putc(*str++);
-    }
-}
-
-void uart_put_hex(unsigned long value) {
-    const char hex_chars[] = "0123456789ABCDEF";
-    uart_puts("0x");
-    
-    for (int i = 60; i >= 0; i -= 4) {
-        uart_putc(hex_chars[(value >> i) & 0xF]);
-    }
-}
-
-void uart_put_dec(unsigned long value) {
-    if (value == 0) {
-        uart_putc('0');
-        return;
-    }
-    
-    char buffer[32];
-    int pos = 0;
-    
-    while (value > 0) {
-        buffer[pos++] = '0' + (value % 10);
-        value /= 10;
-    }
-    
-    for (int i = pos - 1; i >= 0; i--) {
-        uart_putc(buffer[i]);
-    }
-}
-
-void _start(void) {
+// 入口处 x0 为 boot_info，插桩调用会先把它覆盖掉
+__notrace void _start(void) {
     boot_info_t* boot_info;
     
     __asm__ volatile ("mov %0, x0" : "=r" (boot_info));
@@ -145,9 +109,35 @@ void kernel_main(boot_info_t* boot_info){
         uart_put_dec(boot_info->memory_map_desc_count);
         uart_puts("\n");
     }
+
+    rcu_init();
+    smp_boot_cpu_init();
+    irq_init();
+    irq_cpu_init();
+    timers_init();
+    timer_cpu_init();
+    arch_local_irq_enable();
+    smp_init();
+    uart_puts("  CPUs Online: ");
+    uart_put_dec(num_online_cpus());
+    uart_puts("\n");
     uart_puts("\n");
     
-    uart_puts("  Current Time: [Not available in bare metal mode]\n");
+    uint64_t now = ktime_get_ns();
+    uart_puts("  Current Time: ");
+    uart_put_dec(now / NSEC_PER_SEC);
+    uart_puts(".");
+    uint64_t ms = now % NSEC_PER_SEC / NSEC_PER_MSEC;
+    if (ms < 100) {
+        uart_putc('0');
+    }
+    if (ms < 10) {
+        uart_putc('0');
+    }
+    uart_put_dec(ms);
+    uart_puts(" s since counter reset (");
+    uart_put_dec(clocksource.freq);
+    uart_puts(" Hz)\n");
     
     uart_puts("\n");
     uart_puts("Kernel initialization completed successfully!\n");
@@ -160,7 +150,32 @@ void kernel_main(boot_info_t* boot_info){
     uart_puts("=== RLOS Kernel Main Loop Started ===\n");
     uart_puts("(Press Ctrl+C or close QEMU to exit)\n");
     uart_puts("\n");
-    
-    while(1) {    
+
+#ifdef RLOS_TRACE
+    trace_start();
+#endif
+
+#ifdef RLOS_BENCH
+    rcu_bench_run();
+    uart_puts("\n");
+    timer_bench_run();
+    uart_puts("\n");
+    // make smoke 以此判断基准全部跑完
+    uart_puts("BENCH-DONE\n");
+#endif
+
+#ifdef RLOS_TRACE
+    // 几次短睡眠，留下 中断 -> 定时器 -> 唤醒 的完整路径
+    for (int i = 0; i < 4; i++) {
+        timer_sleep_ns(NSEC_PER_MSEC);
+    }
+    trace_stop();
+    trace_dump();
+    uart_puts("\n");
+#endif
+
+    rcu_idle_enter();
+    while(1) {
+        __asm__ volatile("wfe");
     }
 }
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include "ktime.h"
+#include "arch.h"
+
+struct clocksource clocksource;
+
+void clocksource_init(void) {
+    uint64_t freq = arch_counter_freq();
+
+    clocksource.freq = freq;
+    clocksource.cyc2ns_mult = (NSEC_PER_SEC << 32) / freq;
+    clocksource.ns2cyc_mult = ((freq << 32) + NSEC_PER_SEC - 1) / NSEC_PER_SEC;
+}
+
+uint64_t ktime_get_ns(void) {
+    return clocksource_cyc2ns(arch_counter_read());
+}
+
+void ndelay(uint64_t ns) {
+    uint64_t deadline = ktime_get_ns() + ns;
+
+    while ((int64_t)(ktime_get_ns() - deadline) < 0) {
+        cpu_relax();
+    }
+}
@@ -0,0 +1,327 @@
+#include "rcu.h"
+#include "smp.h"
+#include "spinlock.h"
+#include "trace.h"
+
+// 每次最多执行的回调数，避免一次静止状态中停留过久
+#define RCU_BATCH_LIMIT 16
+
+struct rcu_cblist {
+    struct rcu_head* head;
+    struct rcu_head** tail;
+    uint64_t len;
+};
+
+struct rcu_data {
+    struct rcu_cblist next;     // 尚未分配宽限期的回调
+    struct rcu_cblist wait;     // 等待 wait_gp 结束的回调
+    struct rcu_cblist done;     // 可以执行的回调
+    uint64_t wait_gp;
+    uint64_t qs_count;
+    uint64_t cb_invoked;
+    uint32_t irq_from_idle;     // 当前中断打断的是 idle，退出时恢复
+} __cacheline_aligned;
+
+struct rcu_state {
+    spinlock_t lock;            // 时钟中断里也会获取，必须关中断持有
+    uint64_t gp_seq;            // 最近开始的宽限期编号
+    uint64_t completed;         // 最近结束的宽限期编号
+    uint64_t gp_requested;      // 需要等到的最大宽限期编号
+    uint64_t idle_mask;         // 处于 idle（扩展静止状态）的 CPU
+    uint64_t qs_mask __cacheline_aligned;   // 当前宽限期中尚未报告静止状态的 CPU
+};
+
+static struct rcu_state rcu_state;
+static struct rcu_data rcu_data[NR_CPUS];
+
+#ifdef RLOS_HOST
+// 主机测试在宽限期开始、qs_mask 发布之前插入其他 CPU 的动作
+void (*rcu_host_gp_hook)(void);
+#define rcu_gp_hook()                   \
+    do {                                \
+        if (rcu_host_gp_hook) {         \
+            rcu_host_gp_hook();         \
+        }                               \
+    } while (0)
+#else
+#define rcu_gp_hook() do { } while (0)
+#endif
+
+static void rcu_cblist_init(struct rcu_cblist* list) {
+    list->head = NULL;
+    list->tail = &list->head;
+    list->len = 0;
+}
+
+static void rcu_cblist_enqueue(struct rcu_cblist* list, struct rcu_head* head) {
+    head->next = NULL;
+    *list->tail = head;
+    list->tail = &head->next;
+    list->len++;
+}
+
+static void rcu_cblist_splice(struct rcu_cblist* dst, struct rcu_cblist* src) {
+    if (!src->head) {
+        return;
+    }
+    *dst->tail = src->head;
+    dst->tail = src->tail;
+    dst->len += src->len;
+    rcu_cblist_init(src);
+}
+
+static void rcu_complete_gp_locked(void);
+
+static void rcu_start_gp_locked(void) {
+    WRITE_ONCE(rcu_state.gp_seq, rcu_state.gp_seq + 1);
+    trace_instant(TRACE_RCU_GP_START, 0, rcu_state.gp_seq, 0);
+
+    // 与 rcu_idle_exit 中的屏障配对：看到 CPU 处于 idle，
+    // 就保证它退出 idle 后的读者能看到本次宽限期之前的更新
+    smp_mb();
+
+    uint64_t mask = READ_ONCE(cpu_online_mask) & ~READ_ONCE(rcu_state.idle_mask);
+    if (!mask) {
+        rcu_complete_gp_locked();
+        return;
+    }
+    rcu_gp_hook();
+    smp_store_release(&rcu_state.qs_mask, mask);
+
+    // 读 idle_mask 之后才进入 idle 的 CPU 可能没看到新的 qs_mask 就睡下了，
+    // 发布之后再查一次，替它们报告。与 rcu_idle_enter 中的屏障配对
+    smp_mb();
+    uint64_t idle = READ_ONCE(rcu_state.idle_mask) & mask;
+    if (idle) {
+        uint64_t old = atomic_fetch_and(&rcu_state.qs_mask, ~idle);
+
+        // old 为 0 说明最后一位已被其他 CPU 清掉，由它结束宽限期
+        if (old && !(old & ~idle)) {
+            rcu_complete_gp_locked();
+        }
+    }
+}
+
+static void rcu_complete_gp_locked(void) {
+    smp_store_release(&rcu_state.completed, rcu_state.gp_seq);
+    trace_instant(TRACE_RCU_GP_END, 0, rcu_state.gp_seq, 0);
+
+    if ((int64_t)(rcu_state.gp_requested - rcu_state.completed) > 0) {
+        rcu_start_gp_locked();
+    }
+}
+
+// 返回一个宽限期编号，该宽限期结束时当前已摘除的数据都不再被读者引用
+static uint64_t rcu_request_gp(void) {
+    uint64_t target;
+    uint64_t flags = spin_lock_irqsave(&rcu_state.lock);
+    if (rcu_state.gp_seq == rcu_state.completed) {
+        rcu_start_gp_locked();
+        target = rcu_state.gp_seq;
+    } else {
+        // 进行中的宽限期可能早于本次摘除开始，只能等下一个
+        target = rcu_state.gp_seq + 1;
+        if ((int64_t)(target - rcu_state.gp_requested) > 0) {
+            rcu_state.gp_requested = target;
+        }
+    }
+    spin_unlock_irqrestore(&rcu_state.lock, flags);
+
+    return target;
+}
+
+static void rcu_report_qs(unsigned int cpu) {
+    uint64_t bit = 1ULL << cpu;
+
+    if (likely(!(READ_ONCE(rcu_state.qs_mask) & bit))) {
+        return;
+    }
+
+    // 本 CPU 之前的读侧访问必须先于报告完成
+    smp_mb();
+
+    uint64_t old = atomic_fetch_and(&rcu_state.qs_mask, ~bit);
+    if (old == bit) {
+        uint64_t flags = spin_lock_irqsave(&rcu_state.lock);
+
+        rcu_complete_gp_locked();
+        spin_unlock_irqrestore(&rcu_state.lock, flags);
+    }
+}
+
+static void rcu_advance_cbs(struct rcu_data* rdp) {
+    if (rdp->wait.head &&
+        (int64_t)(smp_load_acquire(&rcu_state.completed) - rdp->wait_gp) >= 0) {
+        rcu_cblist_splice(&rdp->done, &rdp->wait);
+    }
+
+    if (!rdp->wait.head && rdp->next.head) {
+        rcu_cblist_splice(&rdp->wait, &rdp->next);
+        rdp->wait_gp = rcu_request_gp();
+    }
+}
+
+static void rcu_do_batch(struct rcu_data* rdp) {
+    uint64_t flags = arch_local_irq_save();
+    uint32_t n = 0;
+
+    rcu_advance_cbs(rdp);
+    if (!rdp->done.head) {
+        arch_local_irq_restore(flags);
+        return;
+    }
+
+    trace_begin(TRACE_RCU_CALLBACKS, 0, 0, 0);
+    for (; n < RCU_BATCH_LIMIT && rdp->done.head; n++) {
+        struct rcu_head* head = rdp->done.head;
+
+        rdp->done.head = head->next;
+        if (!rdp->done.head) {
+            rdp->done.tail = &rdp->done.head;
+        }
+        rdp->done.len--;
+        rdp->cb_invoked++;
+
+        arch_local_irq_restore(flags);
+        head->func(head);
+        flags = arch_local_irq_save();
+    }
+    trace_end(TRACE_RCU_CALLBACKS, n, 0, 0);
+
+    arch_local_irq_restore(flags);
+}
+
+void rcu_init(void) {
+    spin_lock_init(&rcu_state.lock);
+    rcu_state.gp_seq = 0;
+    rcu_state.completed = 0;
+    rcu_state.gp_requested = 0;
+    rcu_state.idle_mask = 0;
+    rcu_state.qs_mask = 0;
+
+    for (unsigned int cpu = 0; cpu < NR_CPUS; cpu++) {
+        struct rcu_data* rdp = &rcu_data[cpu];
+
+        rcu_cblist_init(&rdp->next);
+        rcu_cblist_init(&rdp->wait);
+        rcu_cblist_init(&rdp->done);
+        rdp->wait_gp = 0;
+        rdp->qs_count = 0;
+        rdp->cb_invoked = 0;
+        rdp->irq_from_idle = 0;
+    }
+}
+
+// 在 CPU 置入 cpu_online_mask 之前调用
+void rcu_cpu_online(unsigned int cpu) {
+    atomic_fetch_and(&rcu_state.idle_mask, ~(1ULL << cpu));
+    smp_mb();
+}
+
+void rcu_note_context_switch(void) {
+    unsigned int cpu = smp_processor_id();
+    struct rcu_data* rdp = &rcu_data[cpu];
+
+    rdp->qs_count++;
+    rcu_report_qs(cpu);
+    rcu_do_batch(rdp);
+}
+
+void rcu_idle_enter(void) {
+    unsigned int cpu = smp_processor_id();
+    struct rcu_data* rdp = &rcu_data[cpu];
+
+    // 回调里可能有读者，必须在标记 idle 之前执行
+    rcu_do_batch(rdp);
+
+    smp_mb();
+    atomic_fetch_or(&rcu_state.idle_mask, 1ULL << cpu);
+    // 与 rcu_start_gp_locked 发布 qs_mask 后的屏障配对：
+    // 要么这里看到新的 qs_mask 自行报告，要么对方看到 idle 位代为报告
+    smp_mb();
+    rcu_report_qs(cpu);
+}
+
+void rcu_idle_exit(void) {
+    unsigned int cpu = smp_processor_id();
+
+    atomic_fetch_and(&rcu_state.idle_mask, ~(1ULL << cpu));
+    smp_mb();
+}
+
+// 中断处理函数（定时器回调等）里可能有读者，打断 idle 时要暂时退出 idle，
+// 否则宽限期会把这个 CPU 当作静止状态跳过。中断不嵌套，无需计数
+void rcu_irq_enter(void) {
+    unsigned int cpu = smp_processor_id();
+    uint64_t bit = 1ULL << cpu;
+
+    if (!(READ_ONCE(rcu_state.idle_mask) & bit)) {
+        return;
+    }
+    rcu_data[cpu].irq_from_idle = 1;
+    rcu_idle_exit();
+}
+
+void rcu_irq_exit(void) {
+    unsigned int cpu = smp_processor_id();
+
+    if (!rcu_data[cpu].irq_from_idle) {
+        return;
+    }
+    rcu_data[cpu].irq_from_idle = 0;
+
+    // 同 rcu_idle_enter 的后半部分，回调已由中断里的 rcu_check_callbacks 推进
+    smp_mb();
+    atomic_fetch_or(&rcu_state.idle_mask, 1ULL << cpu);
+    smp_mb();
+    rcu_report_qs(cpu);
+}
+
+// 时钟中断中调用：中断本身不是静止状态，只推进回调。
+// 打断 idle 时 rcu_irq_enter 已退出 idle；仍处于 idle 则不执行，
+// 回调里的读者不能运行在 idle 的 CPU 上
+void rcu_check_callbacks(void) {
+    unsigned int cpu = smp_processor_id();
+    struct rcu_data* rdp = &rcu_data[cpu];
+
+    if (READ_ONCE(rcu_state.idle_mask) & (1ULL << cpu)) {
+        return;
+    }
+    if (rdp->next.head || rdp->wait.head || rdp->done.head) {
+        rcu_do_batch(rdp);
+    }
+}
+
+void call_rcu(struct rcu_head* head, rcu_callback_t func) {
+    struct rcu_data* rdp;
+    uint64_t flags = arch_local_irq_save();
+
+    head->func = func;
+    rdp = &rcu_data[smp_processor_id()];
+    rcu_cblist_enqueue(&rdp->next, head);
+
+    arch_local_irq_restore(flags);
+}
+
+struct rcu_synchronize {
+    struct rcu_head head;
+    uint32_t done;
+};
+
+static void wakeme_after_rcu(struct rcu_head* head) {
+    struct rcu_synchronize* rs = container_of(head, struct rcu_synchronize, head);
+
+    smp_store_release(&rs->done, 1);
+}
+
+void synchronize_rcu(void) {
+    struct rcu_synchronize rs;
+
+    rs.done = 0;
+    call_rcu(&rs.head, wakeme_after_rcu);
+
+    while (!smp_load_acquire(&rs.done)) {
+        rcu_note_context_switch();
+        cpu_relax();
+    }
+}
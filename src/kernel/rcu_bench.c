@@ -0,0 +1,155 @@
+#include "kernel.h"
+#include "bench.h"
+#include "hashtable.h"
+#include "spinlock.h"
+#include "smp.h"
+
+// 读扩展性测试：多核并发查找同一张哈希表，RCU 对比读写锁
+
+#define BENCH_KEYS          1024
+#define BENCH_BATCH         256
+#define BENCH_DURATION_MS   200
+#define BENCH_START_MS      5
+
+enum {
+    BENCH_MODE_RCU,
+    BENCH_MODE_RWLOCK,
+};
+
+struct bench_node {
+    struct hlist_node node;
+    uint64_t key;
+    uint64_t value;
+};
+
+struct bench_worker {
+    uint64_t ops;
+    uint64_t checksum;
+    uint64_t seed;
+} __cacheline_aligned;
+
+static struct bench_node bench_nodes[BENCH_KEYS];
+static struct hlist_head bench_table[1 << 10];
+static rwlock_t bench_rwlock;
+static struct bench_worker bench_workers[NR_CPUS];
+
+static int bench_mode;
+static uint64_t bench_start;
+static uint64_t bench_end;
+
+static struct bench_node* bench_lookup(uint64_t key) {
+    struct bench_node* n;
+
+    hash_for_each_possible_rcu(bench_table, n, node, key) {
+        if (n->key == key) {
+            return n;
+        }
+    }
+    return NULL;
+}
+
+static void bench_reader(void* arg) {
+    struct bench_worker* w = arg;
+    uint64_t seed = w->seed;
+    uint64_t ops = 0;
+    uint64_t sum = 0;
+    int mode = READ_ONCE(bench_mode);
+    uint64_t start = READ_ONCE(bench_start);
+    uint64_t end = READ_ONCE(bench_end);
+
+    while ((int64_t)(arch_counter_read() - start) < 0) {
+        cpu_relax();
+    }
+
+    while ((int64_t)(arch_counter_read() - end) < 0) {
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            uint64_t key = seed % BENCH_KEYS;
+            struct bench_node* n;
+
+            if (mode == BENCH_MODE_RCU) {
+                rcu_read_lock();
+                n = bench_lookup(key);
+                if (n) {
+                    sum += n->value;
+                }
+                rcu_read_unlock();
+            } else {
+                read_lock(&bench_rwlock);
+                n = bench_lookup(key);
+                if (n) {
+                    sum += n->value;
+                }
+                read_unlock(&bench_rwlock);
+            }
+        }
+        ops += BENCH_BATCH;
+
+        if (mode == BENCH_MODE_RCU) {
+            rcu_note_context_switch();
+        }
+    }
+
+    w->ops = ops;
+    w->checksum = sum;
+}
+
+static uint64_t bench_run_once(int mode, unsigned int ncpus) {
+    uint64_t freq = arch_counter_freq();
+    uint64_t ops = 0;
+
+    bench_mode = mode;
+    bench_start = arch_counter_read() + freq / 1000 * BENCH_START_MS;
+    bench_end = bench_start + freq / 1000 * BENCH_DURATION_MS;
+
+    for (unsigned int cpu = 0; cpu < ncpus; cpu++) {
+        bench_workers[cpu].ops = 0;
+        bench_workers[cpu].seed = 0x9E3779B97F4A7C15ULL * (cpu + 1);
+    }
+    smp_mb();
+
+    for (unsigned int cpu = 1; cpu < ncpus; cpu++) {
+        smp_call_on(cpu, bench_reader, &bench_workers[cpu]);
+    }
+    bench_reader(&bench_workers[0]);
+    for (unsigned int cpu = 1; cpu < ncpus; cpu++) {
+        smp_call_wait(cpu);
+    }
+
+    for (unsigned int cpu = 0; cpu < ncpus; cpu++) {
+        ops += bench_workers[cpu].ops;
+    }
+
+    return ops * freq / (bench_end - bench_start);
+}
+
+void rcu_bench_run(void) {
+    unsigned int online = num_online_cpus();
+
+    hash_init(bench_table);
+    rwlock_init(&bench_rwlock);
+    for (uint64_t i = 0; i < BENCH_KEYS; i++) {
+        bench_nodes[i].key = i;
+        bench_nodes[i].value = i * 3 + 1;
+        hash_add_rcu(bench_table, &bench_nodes[i].node, i);
+    }
+    synchronize_rcu();
+
+    uart_puts("RCU read-side scalability (hash lookups/sec):\n");
+    for (unsigned int ncpus = 1; ncpus <= online; ncpus++) {
+        uint64_t rcu = bench_run_once(BENCH_MODE_RCU, ncpus);
+        uint64_t rw = bench_run_once(BENCH_MODE_RWLOCK, ncpus);
+
+        uart_puts("BENCH rcu_lookup cpus=");
+        uart_put_dec(ncpus);
+        uart_puts(" rcu_ops_per_sec=");
+        uart_put_dec(rcu);
+        uart_puts(" rwlock_ops_per_sec=");
+        uart_put_dec(rw);
+        uart_puts(" speedup_x100=");
+        uart_put_dec(rw ? rcu * 100 / rw : 0);
+        uart_puts("\n");
+    }
+}
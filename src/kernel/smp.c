@@ -0,0 +1,168 @@
+#include "kernel.h"
+#include "smp.h"
+#include "rcu.h"
+#include "irq.h"
+#include "timer.h"
+#include "trace.h"
+
+#define PSCI_CPU_ON_64        0xC4000003
+#define PSCI_SUCCESS          0
+
+#define SMP_STACK_SIZE        0x4000
+#define SMP_BOOT_TIMEOUT_MS   1000
+
+// 布局与 smp_entry.S 保持一致
+struct smp_boot_args {
+    uint64_t mair;
+    uint64_t tcr;
+    uint64_t ttbr0;
+    uint64_t sctlr;
+    uint64_t stack_top;
+    uint64_t cpu;
+    uint64_t entry;
+} __cacheline_aligned;
+
+struct smp_call {
+    smp_call_func_t func;
+    void* arg;
+    uint32_t pending;
+} __cacheline_aligned;
+
+uint64_t cpu_online_mask;
+
+static struct smp_boot_args smp_boot_args[NR_CPUS];
+static struct smp_call smp_calls[NR_CPUS];
+static uint8_t smp_stacks[NR_CPUS][SMP_STACK_SIZE] __aligned(16);
+
+extern char secondary_entry[];
+extern char secondary_entry_end[];
+
+// QEMU virt 没有 EL2/EL3 固件时，PSCI 走 HVC
+static int64_t psci_call(uint64_t fn, uint64_t arg0, uint64_t arg1, uint64_t arg2) {
+    register uint64_t x0 __asm__("x0") = fn;
+    register uint64_t x1 __asm__("x1") = arg0;
+    register uint64_t x2 __asm__("x2") = arg1;
+    register uint64_t x3 __asm__("x3") = arg2;
+
+    __asm__ volatile ("hvc #0"
+                      : "+r" (x0), "+r" (x1), "+r" (x2), "+r" (x3)
+                      :
+                      : "x4", "x5", "x6", "x7", "x8", "x9", "x10", "x11",
+                        "x12", "x13", "x14", "x15", "x16", "x17", "memory");
+
+    return (int64_t)x0;
+}
+
+static __noreturn void smp_idle_loop(unsigned int cpu) {
+    struct smp_call* call = &smp_calls[cpu];
+
+    for (;;) {
+        rcu_idle_enter();
+        trace_begin(TRACE_IDLE, 0, 0, 0);
+        while (!smp_load_acquire(&call->pending)) {
+            arch_wfe();
+        }
+        trace_end(TRACE_IDLE, 0, 0, 0);
+        rcu_idle_exit();
+
+        trace_begin(TRACE_SMP_CALL, 0, trace_text_offset(call->func), 0);
+        call->func(call->arg);
+        trace_end(TRACE_SMP_CALL, 0, 0, 0);
+
+        smp_store_release(&call->pending, 0);
+        arch_sev();
+    }
+}
+
+// 设置 tpidr_el1 之前 smp_processor_id 无效，不能进入追踪
+__noreturn __notrace void secondary_start(unsigned int cpu) {
+    arch_set_cpu_id(cpu);
+    irq_cpu_init();
+    timer_cpu_init();
+    rcu_cpu_online(cpu);
+
+    atomic_fetch_or(&cpu_online_mask, 1ULL << cpu);
+    arch_sev();
+
+    arch_local_irq_enable();
+    smp_idle_loop(cpu);
+}
+
+void smp_boot_cpu_init(void) {
+    arch_set_cpu_id(0);
+    rcu_cpu_online(0);
+    atomic_fetch_or(&cpu_online_mask, 1ULL);
+}
+
+static int smp_boot_secondary(unsigned int cpu, uint64_t mpidr) {
+    struct smp_boot_args* args = &smp_boot_args[cpu];
+
+    __asm__ volatile ("mrs %0, mair_el1" : "=r" (args->mair));
+    __asm__ volatile ("mrs %0, tcr_el1" : "=r" (args->tcr));
+    __asm__ volatile ("mrs %0, ttbr0_el1" : "=r" (args->ttbr0));
+    __asm__ volatile ("mrs %0, sctlr_el1" : "=r" (args->sctlr));
+    args->stack_top = (uint64_t)&smp_stacks[cpu][SMP_STACK_SIZE];
+    args->cpu = cpu;
+    args->entry = (uint64_t)secondary_start;
+
+    // 从核在 MMU 关闭时读取参数和入口代码
+    arch_dcache_clean_range(args, sizeof(*args));
+    arch_dcache_clean_range(secondary_entry, (uint64_t)(secondary_entry_end - secondary_entry));
+
+    int64_t ret = psci_call(PSCI_CPU_ON_64, mpidr, (uint64_t)secondary_entry, (uint64_t)args);
+    if (ret != PSCI_SUCCESS) {
+        return -1;
+    }
+
+    uint64_t deadline = arch_counter_read() + arch_counter_freq() / 1000 * SMP_BOOT_TIMEOUT_MS;
+    while (!cpu_online(cpu)) {
+        if ((int64_t)(arch_counter_read() - deadline) > 0) {
+            return -1;
+        }
+        cpu_relax();
+    }
+
+    return 0;
+}
+
+void smp_init(void) {
+    if (arch_current_el() != 1) {
+        uart_puts("  SMP: not at EL1, secondary CPUs left offline\n");
+        return;
+    }
+
+    // 假定 Aff0 连续编号 (QEMU virt)，其余亲和级沿用主核
+    uint64_t cluster = arch_read_mpidr() & 0xFF00FFFF00ULL;
+
+    for (unsigned int cpu = 1; cpu < NR_CPUS; cpu++) {
+        if (smp_boot_secondary(cpu, cluster | cpu) != 0) {
+            break;
+        }
+    }
+}
+
+int smp_call_on(unsigned int cpu, smp_call_func_t func, void* arg) {
+    struct smp_call* call;
+
+    if (cpu >= NR_CPUS || !cpu_online(cpu) || cpu == smp_processor_id()) {
+        return -1;
+    }
+
+    call = &smp_calls[cpu];
+    if (smp_load_acquire(&call->pending)) {
+        return -1;
+    }
+
+    call->func = func;
+    call->arg = arg;
+    smp_store_release(&call->pending, 1);
+    arch_sev();
+
+    return 0;
+}
+
+void smp_call_wait(unsigned int cpu) {
+    while (smp_load_acquire(&smp_calls[cpu].pending)) {
+        arch_wfe();
+    }
+}
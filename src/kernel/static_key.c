@@ -0,0 +1,37 @@
+#include "static_key.h"
+#include "arch.h"
+#include "spinlock.h"
+
+extern struct jump_entry __start___jump_table[];
+extern struct jump_entry __stop___jump_table[];
+
+static spinlock_t static_key_lock;
+
+static void static_key_update(struct static_key* key, uint32_t enabled) {
+    spin_lock(&static_key_lock);
+
+    if (key->enabled != enabled) {
+        __atomic_store_n(&key->enabled, enabled, __ATOMIC_RELAXED);
+
+        for (struct jump_entry* entry = __start___jump_table; entry < __stop___jump_table; entry++) {
+            uint64_t code = (uint64_t)&entry->code + entry->code;
+            uint64_t target = (uint64_t)&entry->target + entry->target;
+            uint64_t entry_key = (uint64_t)&entry->key + entry->key;
+
+            if (entry_key != (uint64_t)key) {
+                continue;
+            }
+            arch_patch_insn((uint32_t*)code, enabled ? aarch64_insn_b(code, target) : AARCH64_INSN_NOP);
+        }
+    }
+
+    spin_unlock(&static_key_lock);
+}
+
+void static_key_enable(struct static_key* key) {
+    static_key_update(key, 1);
+}
+
+void static_key_disable(struct static_key* key) {
+    static_key_update(key, 0);
+}
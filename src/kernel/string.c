@@ -0,0 +1,102 @@
+#include "string.h"
+
+// 按 8 字节批量读写；须以 -fno-tree-loop-distribute-patterns 编译，
+// 否则 GCC 会把这里的循环重新识别成对 memset/memcpy 自身的调用
+
+typedef uint64_t __attribute__((may_alias)) word_t;
+
+#define WORD_SIZE  sizeof(word_t)
+#define WORD_MASK  (WORD_SIZE - 1)
+
+void* memset(void* dst, int c, size_t n) {
+    uint8_t* d = dst;
+    word_t pattern = (uint8_t)c * 0x0101010101010101ULL;
+
+    while (n && ((uintptr_t)d & WORD_MASK)) {
+        *d++ = (uint8_t)c;
+        n--;
+    }
+    for (; n >= WORD_SIZE; n -= WORD_SIZE, d += WORD_SIZE) {
+        *(word_t*)d = pattern;
+    }
+    while (n--) {
+        *d++ = (uint8_t)c;
+    }
+
+    return dst;
+}
+
+void* memcpy(void* dst, const void* src, size_t n) {
+    uint8_t* d = dst;
+    const uint8_t* s = src;
+
+    if ((((uintptr_t)d ^ (uintptr_t)s) & WORD_MASK) == 0) {
+        while (n && ((uintptr_t)d & WORD_MASK)) {
+            *d++ = *s++;
+            n--;
+        }
+        for (; n >= WORD_SIZE; n -= WORD_SIZE, d += WORD_SIZE, s += WORD_SIZE) {
+            *(word_t*)d = *(const word_t*)s;
+        }
+    }
+    while (n--) {
+        *d++ = *s++;
+    }
+
+    return dst;
+}
+
+void* memmove(void* dst, const void* src, size_t n) {
+    uint8_t* d = dst;
+    const uint8_t* s = src;
+
+    if (d <= s || d >= s + n) {
+        return memcpy(dst, src, n);
+    }
+
+    d += n;
+    s += n;
+    while (n--) {
+        *--d = *--s;
+    }
+
+    return dst;
+}
+
+int memcmp(const void* a, const void* b, size_t n) {
+    const uint8_t* pa = a;
+    const uint8_t* pb = b;
+
+    for (; n; n--, pa++, pb++) {
+        if (*pa != *pb) {
+            return *pa - *pb;
+        }
+    }
+    return 0;
+}
+
+size_t strlen(const char* str) {
+    const char* p = str;
+
+    while (*p) {
+        p++;
+    }
+    return (size_t)(p - str);
+}
+
+int strcmp(const char* a, const char* b) {
+    while (*a && *a == *b) {
+        a++;
+        b++;
+    }
+    return (uint8_t)*a - (uint8_t)*b;
+}
+
+int strncmp(const char* a, const char* b, size_t n) {
+    for (; n; n--, a++, b++) {
+        if (*a != *b || !*a) {
+            return (uint8_t)*a - (uint8_t)*b;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,480 @@
+#include "timer.h"
+#include "irq.h"
+#include "rcu.h"
+#include "smp.h"
+#include "spinlock.h"
+#include "trace.h"
+
+// 经典层级时间轮：tv1 256 槽，tvn[0..3] 各 64 槽，共覆盖 2^32 个节拍
+#define TVR_BITS     8
+#define TVN_BITS     6
+#define TVR_SIZE     (1 << TVR_BITS)
+#define TVN_SIZE     (1 << TVN_BITS)
+#define TVR_MASK     (TVR_SIZE - 1)
+#define TVN_MASK     (TVN_SIZE - 1)
+#define TVN_LEVELS   4
+#define TIMER_MAX_TICKS  ((1ULL << (TVR_BITS + TVN_LEVELS * TVN_BITS)) - 1)
+
+#define TVN_INDEX(clk, n) (((clk) >> (TVR_BITS + (n) * TVN_BITS)) & TVN_MASK)
+
+// 槽号：tv1 为 0..255，tvn[n][i] 为 TVN_SLOT(n, i)。
+// pending_map 中每个非空槽占一位，用来直接找出下一个要处理的节拍，
+// 比较器只在那时触发，而不是每个节拍都触发一次
+#define WHEEL_SLOTS       (TVR_SIZE + TVN_LEVELS * TVN_SIZE)
+#define TVN_SLOT(n, i)    (TVR_SIZE + (n) * TVN_SIZE + (i))
+#define TV1_MAP_WORDS     (TVR_SIZE / 64)
+
+struct timer_base {
+    spinlock_t lock;
+    uint64_t clk;               // 下一个待处理的节拍
+    uint64_t wheel_pending;
+    uint64_t next_event;        // 已编程到比较器的时刻 (ns)，UINT64_MAX 表示关闭
+    uint32_t heap_len;
+    uint64_t pending_map[WHEEL_SLOTS / 64];
+    struct timer* heap[HRTIMER_HEAP_SIZE];
+    struct list_head tv1[TVR_SIZE];
+    struct list_head tvn[TVN_LEVELS][TVN_SIZE];
+} __cacheline_aligned;
+
+static struct timer_base timer_bases[NR_CPUS];
+
+// 迁移期间 timer->cpu 取此值，timer_lock_base 需等待迁移完成
+#define TIMER_CPU_MIGRATING 0xFF
+
+#ifdef RLOS_HOST
+// 主机测试在迁移窗口（已放开旧 base、未锁新 base）插入其他 CPU 的动作
+void (*timer_host_migrate_hook)(struct timer* timer);
+#define timer_migrate_hook(timer)               \
+    do {                                        \
+        if (timer_host_migrate_hook) {          \
+            timer_host_migrate_hook(timer);     \
+        }                                       \
+    } while (0)
+#else
+#define timer_migrate_hook(timer) do { } while (0)
+#endif
+
+static inline uint64_t timer_tick_of(uint64_t ns) {
+    return (ns + TIMER_TICK_NS - 1) / TIMER_TICK_NS;
+}
+
+static struct list_head* wheel_slot(struct timer_base* base, uint32_t slot) {
+    if (slot < TVR_SIZE) {
+        return &base->tv1[slot];
+    }
+    slot -= TVR_SIZE;
+    return &base->tvn[slot >> TVN_BITS][slot & TVN_MASK];
+}
+
+// 槽被清空后调用
+static inline void wheel_slot_clear(struct timer_base* base, uint32_t slot) {
+    base->pending_map[slot / 64] &= ~(1ULL << (slot % 64));
+}
+
+static void wheel_add(struct timer_base* base, struct timer* timer) {
+    uint64_t expires = timer_tick_of(timer->expires);
+    uint64_t idx = expires - base->clk;
+    uint32_t slot;
+
+    if ((int64_t)idx < 0) {
+        slot = base->clk & TVR_MASK;
+    } else if (idx < TVR_SIZE) {
+        slot = expires & TVR_MASK;
+    } else if (idx < 1ULL << (TVR_BITS + TVN_BITS)) {
+        slot = TVN_SLOT(0, TVN_INDEX(expires, 0));
+    } else if (idx < 1ULL << (TVR_BITS + 2 * TVN_BITS)) {
+        slot = TVN_SLOT(1, TVN_INDEX(expires, 1));
+    } else if (idx < 1ULL << (TVR_BITS + 3 * TVN_BITS)) {
+        slot = TVN_SLOT(2, TVN_INDEX(expires, 2));
+    } else {
+        if (idx > TIMER_MAX_TICKS) {
+            expires = base->clk + TIMER_MAX_TICKS;
+        }
+        slot = TVN_SLOT(3, TVN_INDEX(expires, 3));
+    }
+
+    list_add_tail(&timer->entry, wheel_slot(base, slot));
+    base->pending_map[slot / 64] |= 1ULL << (slot % 64);
+    timer->slot = slot;
+    timer->state = TIMER_WHEEL;
+}
+
+// 下一个需要处理的节拍：tv1 中最早的非空槽，或某个非空 tvn 槽的迁移时刻。
+// tvn[n] 的槽 i 在第一个满足低位全 0 且该层索引为 i 的节拍迁移到低层
+static uint64_t wheel_next_tick(struct timer_base* base) {
+    uint64_t clk = base->clk;
+    uint64_t next = UINT64_MAX;
+    uint32_t start = clk & TVR_MASK;
+
+    // 从当前槽起环形查找，最后一轮回到起始字的低位部分
+    for (uint32_t i = 0; i <= TV1_MAP_WORDS; i++) {
+        uint32_t word = (start / 64 + i) % TV1_MAP_WORDS;
+        uint64_t bits = base->pending_map[word];
+
+        if (i == 0) {
+            bits &= ~0ULL << (start % 64);
+        } else if (i == TV1_MAP_WORDS) {
+            bits &= ~(~0ULL << (start % 64));
+        }
+        if (bits) {
+            uint32_t slot = word * 64 + __builtin_ctzll(bits);
+
+            next = clk + ((slot - start) & TVR_MASK);
+            break;
+        }
+    }
+
+    for (int n = 0; n < TVN_LEVELS; n++) {
+        uint64_t bits = base->pending_map[TV1_MAP_WORDS + n];
+
+        if (!bits) {
+            continue;
+        }
+
+        int shift = TVR_BITS + n * TVN_BITS;
+        uint64_t q = (clk + (1ULL << shift) - 1) >> shift;
+        uint32_t rot = q & TVN_MASK;
+        uint64_t rotated = rot ? (bits >> rot) | (bits << (TVN_SIZE - rot)) : bits;
+        uint64_t tick = (q + __builtin_ctzll(rotated)) << shift;
+
+        if (tick < next) {
+            next = tick;
+        }
+    }
+
+    return next;
+}
+
+static void heap_set(struct timer_base* base, uint32_t i, struct timer* timer) {
+    base->heap[i] = timer;
+    timer->heap_index = i;
+}
+
+static void heap_sift_up(struct timer_base* base, uint32_t i) {
+    struct timer* timer = base->heap[i];
+
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+
+        if (base->heap[parent]->expires <= timer->expires) {
+            break;
+        }
+        heap_set(base, i, base->heap[parent]);
+        i = parent;
+    }
+    heap_set(base, i, timer);
+}
+
+static void heap_sift_down(struct timer_base* base, uint32_t i) {
+    struct timer* timer = base->heap[i];
+
+    for (;;) {
+        uint32_t child = 2 * i + 1;
+
+        if (child >= base->heap_len) {
+            break;
+        }
+        if (child + 1 < base->heap_len &&
+            base->heap[child + 1]->expires < base->heap[child]->expires) {
+            child++;
+        }
+        if (timer->expires <= base->heap[child]->expires) {
+            break;
+        }
+        heap_set(base, i, base->heap[child]);
+        i = child;
+    }
+    heap_set(base, i, timer);
+}
+
+static void heap_add(struct timer_base* base, struct timer* timer) {
+    heap_set(base, base->heap_len++, timer);
+    heap_sift_up(base, timer->heap_index);
+    timer->state = TIMER_HEAP;
+}
+
+static void heap_remove(struct timer_base* base, struct timer* timer) {
+    uint32_t i = timer->heap_index;
+    uint32_t last = --base->heap_len;
+
+    if (i != last) {
+        struct timer* moved = base->heap[last];
+
+        heap_set(base, i, moved);
+        heap_sift_down(base, i);
+        heap_sift_up(base, moved->heap_index);
+    }
+}
+
+static void timer_detach(struct timer_base* base, struct timer* timer) {
+    if (timer->state == TIMER_WHEEL) {
+        list_del(&timer->entry);
+        if (list_empty(wheel_slot(base, timer->slot))) {
+            wheel_slot_clear(base, timer->slot);
+        }
+        base->wheel_pending--;
+    } else if (timer->state == TIMER_HEAP) {
+        heap_remove(base, timer);
+    }
+    WRITE_ONCE(timer->state, TIMER_IDLE);
+}
+
+static void timer_program(struct timer_base* base) {
+    uint64_t next = UINT64_MAX;
+
+    if (base->heap_len) {
+        next = base->heap[0]->expires;
+    }
+    if (base->wheel_pending) {
+        uint64_t wheel_next = wheel_next_tick(base) * TIMER_TICK_NS;
+
+        if (wheel_next < next) {
+            next = wheel_next;
+        }
+    }
+
+    if (next == base->next_event) {
+        return;
+    }
+    base->next_event = next;
+
+    if (next == UINT64_MAX) {
+        arch_timer_disable();
+    } else {
+        arch_timer_set_cval(clocksource_ns2cyc(next));
+    }
+}
+
+static int wheel_cascade(struct timer_base* base, int level, uint64_t index) {
+    struct list_head* vec = &base->tvn[level][index];
+
+    while (!list_empty(vec)) {
+        struct timer* timer = list_first_entry(vec, struct timer, entry);
+
+        list_del(&timer->entry);
+        wheel_add(base, timer);
+    }
+    wheel_slot_clear(base, TVN_SLOT(level, index));
+
+    return (int)index;
+}
+
+static void timer_run(struct timer_base* base, struct timer* timer, uint64_t* flags) {
+    timer_func_t func = timer->func;
+
+    WRITE_ONCE(timer->state, TIMER_IDLE);
+    spin_unlock_irqrestore(&base->lock, *flags);
+    trace_begin(TRACE_TIMER_EXPIRE, 0, timer->expires, ktime_get_ns());
+    func(timer);
+    trace_end(TRACE_TIMER_EXPIRE, 0, 0, 0);
+    *flags = spin_lock_irqsave(&base->lock);
+}
+
+static void timer_run_expired(struct timer_base* base, uint64_t now, uint64_t* flags) {
+    while (base->heap_len && base->heap[0]->expires <= now) {
+        struct timer* timer = base->heap[0];
+
+        heap_remove(base, timer);
+        timer_run(base, timer, flags);
+    }
+
+    uint64_t now_tick = now / TIMER_TICK_NS;
+
+    while (base->wheel_pending) {
+        uint64_t next = wheel_next_tick(base);
+
+        // 中间的节拍没有到期或需要迁移的槽，直接跳过
+        if ((int64_t)(now_tick - next) < 0) {
+            base->clk = now_tick + 1;
+            break;
+        }
+        base->clk = next;
+
+        uint64_t index = base->clk & TVR_MASK;
+
+        if (!index &&
+            !wheel_cascade(base, 0, TVN_INDEX(base->clk, 0)) &&
+            !wheel_cascade(base, 1, TVN_INDEX(base->clk, 1)) &&
+            !wheel_cascade(base, 2, TVN_INDEX(base->clk, 2))) {
+            wheel_cascade(base, 3, TVN_INDEX(base->clk, 3));
+        }
+        base->clk++;
+
+        struct list_head* vec = &base->tv1[index];
+        while (!list_empty(vec)) {
+            struct timer* timer = list_first_entry(vec, struct timer, entry);
+
+            list_del(&timer->entry);
+            base->wheel_pending--;
+            timer_run(base, timer, flags);
+        }
+        wheel_slot_clear(base, index);
+    }
+
+    if (!base->wheel_pending) {
+        base->clk = now_tick + 1;
+    }
+}
+
+static void timer_interrupt(uint32_t intid) {
+    struct timer_base* base = &timer_bases[smp_processor_id()];
+    uint64_t flags;
+
+    (void)intid;
+
+    flags = spin_lock_irqsave(&base->lock);
+    base->next_event = UINT64_MAX;
+    arch_timer_disable();
+    timer_run_expired(base, ktime_get_ns(), &flags);
+    timer_program(base);
+    spin_unlock_irqrestore(&base->lock, flags);
+
+    rcu_check_callbacks();
+}
+
+void timers_init(void) {
+    clocksource_init();
+
+    for (unsigned int cpu = 0; cpu < NR_CPUS; cpu++) {
+        struct timer_base* base = &timer_bases[cpu];
+
+        spin_lock_init(&base->lock);
+        base->clk = 0;
+        base->wheel_pending = 0;
+        base->next_event = UINT64_MAX;
+        base->heap_len = 0;
+        for (unsigned int i = 0; i < ARRAY_SIZE(base->pending_map); i++) {
+            base->pending_map[i] = 0;
+        }
+        for (int i = 0; i < TVR_SIZE; i++) {
+            INIT_LIST_HEAD(&base->tv1[i]);
+        }
+        for (int n = 0; n < TVN_LEVELS; n++) {
+            for (int i = 0; i < TVN_SIZE; i++) {
+                INIT_LIST_HEAD(&base->tvn[n][i]);
+            }
+        }
+    }
+
+    irq_register(IRQ_PPI_VTIMER, timer_interrupt);
+}
+
+void timer_cpu_init(void) {
+    struct timer_base* base = &timer_bases[smp_processor_id()];
+
+    base->clk = timer_tick_of(ktime_get_ns());
+    arch_timer_disable();
+    irq_enable(IRQ_PPI_VTIMER);
+}
+
+void timer_init(struct timer* timer, timer_func_t func) {
+    timer->entry.next = NULL;
+    timer->entry.prev = NULL;
+    timer->expires = 0;
+    timer->func = func;
+    timer->heap_index = 0;
+    timer->state = TIMER_IDLE;
+    timer->cpu = 0;
+    timer->slot = 0;
+}
+
+// 锁住 timer 当前所在的 base，期间 timer 可能被其他 CPU 迁移，需要重试
+static struct timer_base* timer_lock_base(struct timer* timer, uint64_t* flags) {
+    for (;;) {
+        unsigned int cpu = READ_ONCE(timer->cpu);
+
+        if (cpu == TIMER_CPU_MIGRATING) {
+            cpu_relax();
+            continue;
+        }
+
+        struct timer_base* base = &timer_bases[cpu];
+
+        *flags = spin_lock_irqsave(&base->lock);
+        if (READ_ONCE(timer->cpu) == cpu) {
+            return base;
+        }
+        spin_unlock_irqrestore(&base->lock, *flags);
+    }
+}
+
+int timer_cancel(struct timer* timer) {
+    uint64_t flags;
+    struct timer_base* base = timer_lock_base(timer, &flags);
+    int pending = timer->state != TIMER_IDLE;
+
+    if (pending) {
+        timer_detach(base, timer);
+    }
+    spin_unlock_irqrestore(&base->lock, flags);
+
+    return pending;
+}
+
+void timer_start(struct timer* timer, uint64_t expires) {
+    uint64_t flags;
+    unsigned int cpu = smp_processor_id();
+    struct timer_base* base = timer_lock_base(timer, &flags);
+
+    if (timer->state != TIMER_IDLE) {
+        timer_detach(base, timer);
+    }
+
+    // 放开旧 base 之前先标记迁移中，否则其他 CPU 仍能锁住旧 base
+    // 并通过 timer->cpu 检查，在错误的 base 上摘除定时器
+    if (base != &timer_bases[cpu]) {
+        WRITE_ONCE(timer->cpu, TIMER_CPU_MIGRATING);
+        spin_unlock(&base->lock);
+        timer_migrate_hook(timer);
+        base = &timer_bases[cpu];
+        spin_lock(&base->lock);
+        WRITE_ONCE(timer->cpu, cpu);
+    }
+
+    uint64_t now = ktime_get_ns();
+
+    timer->expires = expires;
+    if ((int64_t)(expires - now) < (int64_t)TIMER_TICK_NS && base->heap_len < HRTIMER_HEAP_SIZE) {
+        heap_add(base, timer);
+    } else {
+        if (!base->wheel_pending) {
+            base->clk = now / TIMER_TICK_NS + 1;
+        }
+        wheel_add(base, timer);
+        base->wheel_pending++;
+    }
+
+    timer_program(base);
+    spin_unlock_irqrestore(&base->lock, flags);
+}
+
+struct timer_sleeper {
+    struct timer timer;
+    uint32_t done;
+};
+
+static void timer_wakeup(struct timer* timer) {
+    struct timer_sleeper* sleeper = container_of(timer, struct timer_sleeper, timer);
+
+    trace_instant(TRACE_WAKEUP, 0, timer->expires, 0);
+    smp_store_release(&sleeper->done, 1);
+}
+
+void timer_sleep_ns(uint64_t ns) {
+    struct timer_sleeper sleeper;
+
+    timer_init(&sleeper.timer, timer_wakeup);
+    sleeper.done = 0;
+    timer_start(&sleeper.timer, ktime_get_ns() + ns);
+
+    // 关中断后再检查并 wfi：中断在检查之后到来也会挂起并唤醒 wfi，不会丢失
+    for (;;) {
+        arch_local_irq_disable();
+        if (smp_load_acquire(&sleeper.done)) {
+            break;
+        }
+        arch_wfi();
+        arch_local_irq_enable();
+    }
+    arch_local_irq_enable();
+}
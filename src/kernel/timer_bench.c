@@ -0,0 +1,130 @@
+#include "kernel.h"
+#include "bench.h"
+#include "timer.h"
+#include "arch.h"
+
+// 10 万个挂起定时器下的插入/取消开销与触发抖动
+
+#define BENCH_TIMERS         100000
+#define BENCH_JITTER_SAMPLES 200
+
+static struct timer bench_timers[BENCH_TIMERS];
+static uint64_t bench_samples[BENCH_JITTER_SAMPLES];
+
+struct jitter_probe {
+    struct timer timer;
+    uint64_t fired;
+    uint32_t done;
+};
+
+static void bench_timer_nop(struct timer* timer) {
+    (void)timer;
+}
+
+static void bench_probe_fire(struct timer* timer) {
+    struct jitter_probe* probe = container_of(timer, struct jitter_probe, timer);
+
+    probe->fired = ktime_get_ns();
+    smp_store_release(&probe->done, 1);
+}
+
+static uint64_t bench_rand(uint64_t* seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+
+static void bench_sort(uint64_t* v, int n) {
+    for (int i = 1; i < n; i++) {
+        uint64_t x = v[i];
+        int j = i - 1;
+
+        while (j >= 0 && v[j] > x) {
+            v[j + 1] = v[j];
+            j--;
+        }
+        v[j + 1] = x;
+    }
+}
+
+static void bench_report_op(const char* name, uint64_t cycles, uint64_t ops) {
+    uart_puts("BENCH ");
+    uart_puts(name);
+    uart_puts(" pending=");
+    uart_put_dec(BENCH_TIMERS);
+    uart_puts(" ns_per_op_x100=");
+    uart_put_dec(clocksource_cyc2ns(cycles) * 100 / ops);
+    uart_puts(" ops_per_sec=");
+    uart_put_dec(ops * clocksource.freq / (cycles ? cycles : 1));
+    uart_puts("\n");
+}
+
+// 依次设置探测定时器并等待触发，记录实际触发时刻与截止时间之差
+static void bench_jitter(const char* kind, uint64_t min_ns, uint64_t span_ns, uint64_t* seed) {
+    struct jitter_probe probe;
+
+    timer_init(&probe.timer, bench_probe_fire);
+    for (int i = 0; i < BENCH_JITTER_SAMPLES; i++) {
+        uint64_t deadline = ktime_get_ns() + min_ns + bench_rand(seed) % span_ns;
+
+        probe.done = 0;
+        timer_start(&probe.timer, deadline);
+        // 与 timer_sleep_ns 相同，关中断检查后再 wfi 以免丢失唤醒
+        for (;;) {
+            arch_local_irq_disable();
+            if (smp_load_acquire(&probe.done)) {
+                break;
+            }
+            arch_wfi();
+            arch_local_irq_enable();
+        }
+        arch_local_irq_enable();
+        bench_samples[i] = probe.fired - deadline;
+    }
+
+    bench_sort(bench_samples, BENCH_JITTER_SAMPLES);
+    uart_puts("BENCH timer_jitter kind=");
+    uart_puts(kind);
+    uart_puts(" pending=");
+    uart_put_dec(BENCH_TIMERS);
+    uart_puts(" samples=");
+    uart_put_dec(BENCH_JITTER_SAMPLES);
+    uart_puts(" p50_ns=");
+    uart_put_dec(bench_samples[BENCH_JITTER_SAMPLES / 2]);
+    uart_puts(" p99_ns=");
+    uart_put_dec(bench_samples[BENCH_JITTER_SAMPLES * 99 / 100]);
+    uart_puts(" max_ns=");
+    uart_put_dec(bench_samples[BENCH_JITTER_SAMPLES - 1]);
+    uart_puts("\n");
+}
+
+void timer_bench_run(void) {
+    uint64_t seed = 0x2545F4914F6CDD1DULL;
+    uint64_t start, cycles;
+
+    uart_puts("Timer wheel cost and jitter:\n");
+
+    for (int i = 0; i < BENCH_TIMERS; i++) {
+        timer_init(&bench_timers[i], bench_timer_nop);
+    }
+
+    // 截止时间分布在 10s ~ 1000s，保证测量期间不会触发
+    uint64_t base = ktime_get_ns() + 10 * NSEC_PER_SEC;
+    start = arch_counter_read();
+    for (int i = 0; i < BENCH_TIMERS; i++) {
+        timer_start(&bench_timers[i], base + bench_rand(&seed) % (990 * NSEC_PER_SEC));
+    }
+    cycles = arch_counter_read() - start;
+    bench_report_op("timer_insert", cycles, BENCH_TIMERS);
+
+    bench_jitter("hrtimer", 20 * NSEC_PER_USEC, 500 * NSEC_PER_USEC, &seed);
+    bench_jitter("wheel", 2 * NSEC_PER_MSEC, 8 * NSEC_PER_MSEC, &seed);
+
+    start = arch_counter_read();
+    for (int i = 0; i < BENCH_TIMERS; i++) {
+        timer_cancel(&bench_timers[i]);
+    }
+    cycles = arch_counter_read() - start;
+    bench_report_op("timer_cancel", cycles, BENCH_TIMERS);
+}
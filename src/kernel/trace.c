@@ -0,0 +1,105 @@
+#include "kernel.h"
+#include "trace.h"
+#include "arch.h"
+#include "smp.h"
+
+// 每 CPU 4096 条，写满后覆盖最旧的记录
+#define TRACE_BUF_ENTRIES 4096
+
+struct trace_buffer {
+    uint64_t head;
+    struct trace_entry entries[TRACE_BUF_ENTRIES];
+} __cacheline_aligned;
+
+struct static_key trace_key;
+
+static struct trace_buffer trace_buffers[NR_CPUS];
+
+extern char _stext[];
+
+uint64_t trace_text_offset(const void* addr) {
+    return (uint64_t)addr - (uint64_t)_stext;
+}
+
+// 只写本 CPU 的缓冲；原子地占位，允许被中断里的追踪点嵌套
+void __trace_record(uint16_t id, uint8_t phase, uint32_t arg0, uint64_t arg1, uint64_t arg2) {
+    unsigned int cpu = smp_processor_id();
+
+    if (cpu >= NR_CPUS) {
+        return;
+    }
+
+    struct trace_buffer* buf = &trace_buffers[cpu];
+    uint64_t idx = __atomic_fetch_add(&buf->head, 1, __ATOMIC_RELAXED);
+    struct trace_entry* entry = &buf->entries[idx & (TRACE_BUF_ENTRIES - 1)];
+
+    entry->ts = arch_counter_read_relaxed();
+    entry->id = id;
+    entry->cpu = (uint8_t)cpu;
+    entry->phase = phase;
+    entry->arg0 = arg0;
+    entry->arg1 = arg1;
+    entry->arg2 = arg2;
+}
+
+void trace_start(void) {
+    for (unsigned int cpu = 0; cpu < NR_CPUS; cpu++) {
+        WRITE_ONCE(trace_buffers[cpu].head, 0);
+    }
+    smp_mb();
+    static_key_enable(&trace_key);
+}
+
+void trace_stop(void) {
+    static_key_disable(&trace_key);
+    smp_mb();
+}
+
+// 导出格式：
+//   TRACE-BEGIN freq=<Hz> cpus=<n>
+//   TRACE <ts> <id|cpu|phase|arg0> <arg1> <arg2>    （各为 64 位十六进制）
+//   TRACE-END
+void trace_dump(void) {
+    uart_puts("TRACE-BEGIN freq=");
+    uart_put_dec(arch_counter_freq());
+    uart_puts(" cpus=");
+    uart_put_dec(NR_CPUS);
+    uart_puts("\n");
+
+    for (unsigned int cpu = 0; cpu < NR_CPUS; cpu++) {
+        struct trace_buffer* buf = &trace_buffers[cpu];
+        uint64_t head = READ_ONCE(buf->head);
+        uint64_t start = head > TRACE_BUF_ENTRIES ? head - TRACE_BUF_ENTRIES : 0;
+
+        for (uint64_t i = start; i < head; i++) {
+            struct trace_entry* entry = &buf->entries[i & (TRACE_BUF_ENTRIES - 1)];
+
+            uart_puts("TRACE ");
+            uart_put_hex(entry->ts);
+            uart_puts(" ");
+            uart_put_hex((uint64_t)entry->id | (uint64_t)entry->cpu << 16 |
+                         (uint64_t)entry->phase << 24 | (uint64_t)entry->arg0 << 32);
+            uart_puts(" ");
+            uart_put_hex(entry->arg1);
+            uart_puts(" ");
+            uart_put_hex(entry->arg2);
+            uart_puts("\n");
+        }
+    }
+
+    uart_puts("TRACE-END\n");
+}
+
+#ifdef RLOS_TRACE
+// make TRACE=1 时由 -finstrument-functions 插入
+void __cyg_profile_func_enter(void* fn, void* site) __notrace;
+void __cyg_profile_func_exit(void* fn, void* site) __notrace;
+
+void __cyg_profile_func_enter(void* fn, void* site) {
+    trace_begin(TRACE_FUNC, 0, trace_text_offset(fn), trace_text_offset(site));
+}
+
+void __cyg_profile_func_exit(void* fn, void* site) {
+    trace_end(TRACE_FUNC, 0, trace_text_offset(fn), trace_text_offset(site));
+}
+#endif
@@ -0,0 +1,40 @@
+#include "kernel.h"
+
+// 只依赖 uart_putc 的格式化输出，与 PL011 驱动分开，主机测试直接复用
+
+void uart_puts(const char* str) {
+    while (*str) {
+        if (*str == '\n') {
+            uart_putc('\r');
+        }
+        uart_putc(*str++);
+    }
+}
+
+void uart_put_hex(unsigned long value) {
+    const char hex_chars[] = "0123456789ABCDEF";
+    uart_puts("0x");
+    
+    for (int i = 60; i >= 0; i -= 4) {
+        uart_putc(hex_chars[(value >> i) & 0xF]);
+    }
+}
+
+void uart_put_dec(unsigned long value) {
+    if (value == 0) {
+        uart_putc('0');
+        return;
+    }
+    
+    char buffer[32];
+    int pos = 0;
+    
+    while (value > 0) {
+        buffer[pos++] = '0' + (value % 10);
+        value /= 10;
+    }
+    
+    for (int i = pos - 1; i >= 0; i--) {
+        uart_putc(buffer[i]);
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef RLOS_ARCH_HOST_H
+#define RLOS_ARCH_HOST_H
+
+// arch.h 的主机模拟实现，仅用于 make test / make bench。
+// 计数器默认取自 CLOCK_MONOTONIC（按 62.5MHz 换算），
+// 测试可切换为手动推进的假时钟；比较器编程只记录下来，由测试自行“触发”中断
+
+#include "stdint.h"
+
+#define HOST_COUNTER_FREQ 62500000ULL
+
+extern __thread unsigned int host_cpu;
+extern int host_fake_clock;
+extern uint64_t host_fake_counter;
+extern uint64_t host_timer_cval;
+extern int host_timer_enabled;
+
+uint64_t host_counter_read(void);
+
+static inline unsigned int arch_cpu_id(void) {
+    return host_cpu;
+}
+
+static inline void arch_set_cpu_id(unsigned int id) {
+    host_cpu = id;
+}
+
+static inline void cpu_relax(void) {
+    __asm__ volatile ("" ::: "memory");
+}
+
+static inline void arch_wfe(void) {
+    cpu_relax();
+}
+
+static inline void arch_sev(void) {
+}
+
+static inline void arch_wfi(void) {
+    cpu_relax();
+}
+
+static inline uint64_t arch_counter_read(void) {
+    return host_counter_read();
+}
+
+static inline uint64_t arch_counter_read_relaxed(void) {
+    return host_counter_read();
+}
+
+static inline uint64_t arch_counter_freq(void) {
+    return HOST_COUNTER_FREQ;
+}
+
+static inline uint64_t arch_local_irq_save(void) {
+    return 0;
+}
+
+static inline void arch_local_irq_restore(uint64_t flags) {
+    (void)flags;
+}
+
+static inline void arch_local_irq_enable(void) {
+}
+
+static inline void arch_local_irq_disable(void) {
+}
+
+static inline void arch_timer_set_cval(uint64_t cval) {
+    host_timer_cval = cval;
+    host_timer_enabled = 1;
+}
+
+static inline void arch_timer_disable(void) {
+    host_timer_enabled = 0;
+}
+
+#endif /* RLOS_ARCH_HOST_H */
@@ -0,0 +1,30 @@
+#include <efi.h>
+#include "harness.h"
+#include "boot_info.h"
+
+EFI_STATUS ConvertMemoryMap(EFI_MEMORY_DESCRIPTOR* EfiMemoryMap, UINTN EfiMapSize, UINTN EfiDescSize, boot_info_t* boot_info);
+
+#define FIRMWARE_DESC_SIZE 48
+#define BENCH_DESCRIPTORS  128
+
+static uint8_t efi_map[FIRMWARE_DESC_SIZE * BENCH_DESCRIPTORS];
+
+// QEMU virt 上 OVMF 给出的内存图大约一百来项
+BENCH(memmap_convert_128) {
+    boot_info_t info;
+
+    bench_pause();
+    for (int i = 0; i < BENCH_DESCRIPTORS; i++) {
+        EFI_MEMORY_DESCRIPTOR* d = (EFI_MEMORY_DESCRIPTOR*)(efi_map + i * FIRMWARE_DESC_SIZE);
+
+        d->Type = (UINT32)(i % EfiMaxMemoryType);
+        d->PhysicalStart = 0x40000000ULL + (UINT64)i * 0x100000;
+        d->NumberOfPages = 256;
+    }
+    bench_resume();
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        ConvertMemoryMap((EFI_MEMORY_DESCRIPTOR*)efi_map, sizeof(efi_map), FIRMWARE_DESC_SIZE, &info);
+        bench_consume(info.memory_map_desc_count);
+    }
+}
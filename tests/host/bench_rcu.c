@@ -0,0 +1,92 @@
+#include "harness.h"
+#include "hashtable.h"
+#include "rcu.h"
+#include "spinlock.h"
+
+// 单线程下读侧路径本身的开销；多核扩展性见内核中的 rcu_bench
+
+#define BENCH_KEYS 1024
+
+struct bench_node {
+    struct hlist_node node;
+    uint64_t key;
+    uint64_t value;
+};
+
+static struct bench_node nodes[BENCH_KEYS];
+static struct hlist_head table[1 << 10];
+static rwlock_t table_lock;
+
+static void bench_table_setup(void) {
+    static int ready;
+
+    if (ready) {
+        return;
+    }
+    ready = 1;
+
+    hash_init(table);
+    rwlock_init(&table_lock);
+    for (int i = 0; i < BENCH_KEYS; i++) {
+        nodes[i].key = (uint64_t)i;
+        nodes[i].value = (uint64_t)i * 3;
+        hash_add_rcu(table, &nodes[i].node, nodes[i].key);
+    }
+}
+
+static struct bench_node* bench_lookup(uint64_t key) {
+    struct bench_node* n;
+
+    hash_for_each_possible_rcu(table, n, node, key) {
+        if (n->key == key) {
+            return n;
+        }
+    }
+    return NULL;
+}
+
+BENCH(hash_lookup_rcu) {
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    uint64_t sum = 0;
+
+    bench_pause();
+    bench_table_setup();
+    bench_resume();
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        rcu_read_lock();
+        struct bench_node* n = bench_lookup(seed % BENCH_KEYS);
+        if (n) {
+            sum += n->value;
+        }
+        rcu_read_unlock();
+    }
+    bench_consume(sum);
+}
+
+BENCH(hash_lookup_rwlock) {
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    uint64_t sum = 0;
+
+    bench_pause();
+    bench_table_setup();
+    bench_resume();
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        read_lock(&table_lock);
+        struct bench_node* n = bench_lookup(seed % BENCH_KEYS);
+        if (n) {
+            sum += n->value;
+        }
+        read_unlock(&table_lock);
+    }
+    bench_consume(sum);
+}
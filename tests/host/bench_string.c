@@ -0,0 +1,47 @@
+#include "harness.h"
+#include "string.h"
+
+static uint8_t src_buf[4096 + 64] __attribute__((aligned(64)));
+static uint8_t dst_buf[4096 + 64] __attribute__((aligned(64)));
+
+BENCH(memcpy_4k) {
+    for (uint64_t i = 0; i < iterations; i++) {
+        memcpy(dst_buf, src_buf, 4096);
+        __asm__ volatile ("" ::: "memory");
+    }
+}
+
+BENCH(memcpy_4k_unaligned) {
+    for (uint64_t i = 0; i < iterations; i++) {
+        memcpy(dst_buf + 3, src_buf + 1, 4096);
+        __asm__ volatile ("" ::: "memory");
+    }
+}
+
+BENCH(memset_4k) {
+    for (uint64_t i = 0; i < iterations; i++) {
+        memset(dst_buf, (int)i, 4096);
+        __asm__ volatile ("" ::: "memory");
+    }
+}
+
+BENCH(memmove_4k_overlap) {
+    for (uint64_t i = 0; i < iterations; i++) {
+        memmove(dst_buf + 8, dst_buf, 4096);
+        __asm__ volatile ("" ::: "memory");
+    }
+}
+
+BENCH(strlen_64) {
+    static char str[65];
+
+    bench_pause();
+    memset(str, 'a', 64);
+    str[64] = '\0';
+    bench_resume();
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume(strlen(str));
+        __asm__ volatile ("" ::: "memory");
+    }
+}
@@ -0,0 +1,80 @@
+#include "harness.h"
+#include "host.h"
+#include "timer.h"
+
+// 与内核中 timer_bench 相同的场景：已有 10 万个挂起定时器时的插入/取消开销
+
+#define BENCH_PENDING 100000
+#define BENCH_BATCH   1024
+
+static struct timer pending[BENCH_PENDING];
+static struct timer batch[BENCH_BATCH];
+static uint64_t deadlines[BENCH_BATCH];
+
+static void bench_timer_fn(struct timer* timer) {
+    (void)timer;
+}
+
+static void bench_timer_setup(void) {
+    static int ready;
+    uint64_t seed = 88172645463325252ULL;
+
+    if (ready) {
+        return;
+    }
+    ready = 1;
+
+    host_clock_fake(HOST_COUNTER_FREQ);
+    timers_init();
+    timer_cpu_init();
+
+    uint64_t now = ktime_get_ns();
+    for (int i = 0; i < BENCH_PENDING; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        timer_init(&pending[i], bench_timer_fn);
+        timer_start(&pending[i], now + 2 * TIMER_TICK_NS + seed % (10ULL * NSEC_PER_SEC));
+    }
+    for (int i = 0; i < BENCH_BATCH; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        timer_init(&batch[i], bench_timer_fn);
+        deadlines[i] = now + 2 * TIMER_TICK_NS + seed % (10ULL * NSEC_PER_SEC);
+    }
+}
+
+BENCH(timer_start_cancel_wheel) {
+    bench_pause();
+    bench_timer_setup();
+    bench_resume();
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        struct timer* t = &batch[i & (BENCH_BATCH - 1)];
+
+        timer_start(t, deadlines[i & (BENCH_BATCH - 1)]);
+        timer_cancel(t);
+    }
+}
+
+BENCH(timer_start_cancel_hrtimer) {
+    bench_pause();
+    bench_timer_setup();
+    bench_resume();
+
+    uint64_t now = ktime_get_ns();
+    for (uint64_t i = 0; i < iterations; i++) {
+        struct timer* t = &batch[i & 63];
+
+        timer_start(t, now + 1000 + (deadlines[i & (BENCH_BATCH - 1)] & 0xFFFF));
+        if ((i & 63) == 63) {
+            for (int j = 0; j < 64; j++) {
+                timer_cancel(&batch[j]);
+            }
+        }
+    }
+    for (int j = 0; j < 64; j++) {
+        timer_cancel(&batch[j]);
+    }
+}
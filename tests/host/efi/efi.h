@@ -0,0 +1,53 @@
+#ifndef RLOS_HOST_EFI_H
+#define RLOS_HOST_EFI_H
+
+// 主机测试用的最小 EFI 类型定义，与 gnu-efi 保持二进制兼容
+
+#include "stdint.h"
+
+typedef uint8_t   UINT8;
+typedef uint16_t  UINT16;
+typedef uint32_t  UINT32;
+typedef uint64_t  UINT64;
+typedef uint64_t  UINTN;
+typedef UINTN     EFI_STATUS;
+typedef UINT64    EFI_PHYSICAL_ADDRESS;
+typedef UINT64    EFI_VIRTUAL_ADDRESS;
+
+#define EFIERR(a)               (0x8000000000000000ULL | (a))
+#define EFI_ERROR(a)            (((int64_t)(a)) < 0)
+#define EFI_SUCCESS             0
+#define EFI_INVALID_PARAMETER   EFIERR(2)
+#define EFI_OUT_OF_RESOURCES    EFIERR(9)
+
+#define EFI_PAGE_SIZE           4096
+
+typedef enum {
+    EfiReservedMemoryType,
+    EfiLoaderCode,
+    EfiLoaderData,
+    EfiBootServicesCode,
+    EfiBootServicesData,
+    EfiRuntimeServicesCode,
+    EfiRuntimeServicesData,
+    EfiConventionalMemory,
+    EfiUnusableMemory,
+    EfiACPIReclaimMemory,
+    EfiACPIMemoryNVS,
+    EfiMemoryMappedIO,
+    EfiMemoryMappedIOPortSpace,
+    EfiPalCode,
+    EfiPersistentMemory,
+    EfiMaxMemoryType
+} EFI_MEMORY_TYPE;
+
+typedef struct {
+    UINT32                Type;
+    UINT32                Pad;
+    EFI_PHYSICAL_ADDRESS  PhysicalStart;
+    EFI_VIRTUAL_ADDRESS   VirtualStart;
+    UINT64                NumberOfPages;
+    UINT64                Attribute;
+} EFI_MEMORY_DESCRIPTOR;
+
+#endif /* RLOS_HOST_EFI_H */
@@ -0,0 +1,6 @@
+#ifndef RLOS_HOST_EFILIB_H
+#define RLOS_HOST_EFILIB_H
+
+#include "efi.h"
+
+#endif /* RLOS_HOST_EFILIB_H */
@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "harness.h"
+
+#define HARNESS_MAX        256
+#define BENCH_SAMPLES      101
+#define BENCH_SAMPLE_NS    1000000ULL
+
+struct harness_entry {
+    const char* name;
+    test_func_t test;
+    bench_func_t bench;
+};
+
+static struct harness_entry tests[HARNESS_MAX];
+static struct harness_entry benches[HARNESS_MAX];
+static int test_count;
+static int bench_count;
+static int current_failures;
+
+static uint64_t paused_ns;
+static uint64_t pause_start;
+static volatile uint64_t bench_sink;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void harness_add(struct harness_entry* table, int* count, struct harness_entry entry) {
+    if (*count >= HARNESS_MAX) {
+        fprintf(stderr, "harness: too many entries\n");
+        exit(2);
+    }
+    table[(*count)++] = entry;
+}
+
+void harness_register_test(const char* name, test_func_t func) {
+    harness_add(tests, &test_count, (struct harness_entry){ name, func, NULL });
+}
+
+void harness_register_bench(const char* name, bench_func_t func) {
+    harness_add(benches, &bench_count, (struct harness_entry){ name, NULL, func });
+}
+
+void harness_fail(const char* file, int line, const char* expr) {
+    if (!current_failures) {
+        printf("\n");
+    }
+    printf("  %s:%d: %s\n", file, line, expr);
+    current_failures++;
+}
+
+void bench_pause(void) {
+    pause_start = now_ns();
+}
+
+void bench_resume(void) {
+    paused_ns += now_ns() - pause_start;
+}
+
+void bench_consume(uint64_t value) {
+    bench_sink += value;
+}
+
+static int cmp_entry(const void* a, const void* b) {
+    const struct harness_entry* ea = a;
+    const struct harness_entry* eb = b;
+    int i = 0;
+
+    while (ea->name[i] && ea->name[i] == eb->name[i]) {
+        i++;
+    }
+    return (unsigned char)ea->name[i] - (unsigned char)eb->name[i];
+}
+
+static int cmp_double(const void* a, const void* b) {
+    double da = *(const double*)a;
+    double db = *(const double*)b;
+
+    return (da > db) - (da < db);
+}
+
+static int name_matches(const char* name, const char* filter) {
+    if (!filter) {
+        return 1;
+    }
+    for (const char* p = name; *p; p++) {
+        int i = 0;
+        while (filter[i] && p[i] == filter[i]) {
+            i++;
+        }
+        if (!filter[i]) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static uint64_t bench_time(bench_func_t func, uint64_t iterations) {
+    paused_ns = 0;
+    uint64_t start = now_ns();
+    func(iterations);
+    uint64_t elapsed = now_ns() - start;
+
+    return elapsed > paused_ns ? elapsed - paused_ns : 0;
+}
+
+static int run_tests(const char* filter) {
+    int passed = 0;
+    int failed = 0;
+
+    qsort(tests, test_count, sizeof(tests[0]), cmp_entry);
+    for (int i = 0; i < test_count; i++) {
+        if (!name_matches(tests[i].name, filter)) {
+            continue;
+        }
+        current_failures = 0;
+        tests[i].test();
+        if (current_failures) {
+            printf("FAIL %s\n", tests[i].name);
+            failed++;
+        } else {
+            printf("PASS %s\n", tests[i].name);
+            passed++;
+        }
+    }
+
+    printf("TESTS passed=%d failed=%d\n", passed, failed);
+    return failed ? 1 : 0;
+}
+
+// 先倍增迭代次数直到单次采样约 1ms，再采 BENCH_SAMPLES 次取中位数和 p99
+static void run_bench(struct harness_entry* entry) {
+    double per_op[BENCH_SAMPLES];
+    uint64_t iterations = 1;
+
+    while (iterations < (1ULL << 30) && bench_time(entry->bench, iterations) < BENCH_SAMPLE_NS) {
+        iterations *= 2;
+    }
+
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        per_op[i] = (double)bench_time(entry->bench, iterations) / (double)iterations;
+    }
+    qsort(per_op, BENCH_SAMPLES, sizeof(per_op[0]), cmp_double);
+
+    double median = per_op[BENCH_SAMPLES / 2];
+    double p99 = per_op[(BENCH_SAMPLES * 99 + 99) / 100 - 1];
+
+    printf("BENCH %s median_ns=%.2f p99_ns=%.2f ops_per_sec=%.0f\n",
+           entry->name, median, p99, median > 0 ? 1e9 / median : 0.0);
+    fflush(stdout);
+}
+
+static int run_benches(const char* filter) {
+    qsort(benches, bench_count, sizeof(benches[0]), cmp_entry);
+    for (int i = 0; i < bench_count; i++) {
+        if (name_matches(benches[i].name, filter)) {
+            run_bench(&benches[i]);
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : NULL;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    if (bench_count) {
+        return run_benches(filter);
+    }
+    return run_tests(filter);
+}
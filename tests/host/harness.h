@@ -0,0 +1,57 @@
+#ifndef RLOS_HOST_HARNESS_H
+#define RLOS_HOST_HARNESS_H
+
+// 主机端单元测试与微基准框架。
+// TEST/BENCH 通过构造函数自动注册，按名字排序执行，输出格式固定：
+//   PASS <name> / FAIL <name>: <file>:<line>: <expr>
+//   BENCH <name> median_ns=<x> p99_ns=<x> ops_per_sec=<n>
+
+#include "stdint.h"
+
+typedef void (*test_func_t)(void);
+typedef void (*bench_func_t)(uint64_t iterations);
+
+void harness_register_test(const char* name, test_func_t func);
+void harness_register_bench(const char* name, bench_func_t func);
+void harness_fail(const char* file, int line, const char* expr);
+
+// 基准函数里的准备工作不计时
+void bench_pause(void);
+void bench_resume(void);
+
+// 防止基准循环被优化掉
+void bench_consume(uint64_t value);
+
+#define TEST(name)                                                        \
+    static void test_##name(void);                                        \
+    __attribute__((constructor)) static void test_register_##name(void) { \
+        harness_register_test(#name, test_##name);                        \
+    }                                                                     \
+    static void test_##name(void)
+
+#define BENCH(name)                                                        \
+    static void bench_##name(uint64_t iterations);                         \
+    __attribute__((constructor)) static void bench_register_##name(void) { \
+        harness_register_bench(#name, bench_##name);                       \
+    }                                                                      \
+    static void bench_##name(uint64_t iterations)
+
+#define EXPECT(expr)                                      \
+    do {                                                  \
+        if (!(expr)) {                                    \
+            harness_fail(__FILE__, __LINE__, #expr);      \
+        }                                                 \
+    } while (0)
+
+#define EXPECT_EQ(a, b) EXPECT((a) == (b))
+
+// 失败后当前测试没有继续的意义时使用
+#define ASSERT(expr)                                      \
+    do {                                                  \
+        if (!(expr)) {                                    \
+            harness_fail(__FILE__, __LINE__, #expr);      \
+            return;                                       \
+        }                                                 \
+    } while (0)
+
+#endif /* RLOS_HOST_HARNESS_H */
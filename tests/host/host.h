@@ -0,0 +1,23 @@
+#ifndef RLOS_HOST_H
+#define RLOS_HOST_H
+
+// 主机模拟环境的控制接口，见 host_arch.c
+
+#include "stdint.h"
+#include "arch.h"
+
+// 切换到假时钟并设定其计数值（单位为计数器周期）
+void host_clock_fake(uint64_t counter);
+void host_clock_real(void);
+void host_clock_advance_ns(uint64_t ns);
+
+// 若比较器已到期则调用注册的定时器中断处理函数，返回是否触发
+int host_timer_fire_due(void);
+// 假时钟跳到比较器时刻并触发，直到没有编程的事件或达到 limit 次
+uint64_t host_timer_run_all(uint64_t limit);
+
+// 把 uart_* 输出收集到内存，供测试检查
+void host_uart_capture(int enable);
+const char* host_uart_output(void);
+
+#endif /* RLOS_HOST_H */
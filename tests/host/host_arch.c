@@ -0,0 +1,124 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "host.h"
+#include "arch.h"
+#include "irq.h"
+#include "kernel.h"
+
+__thread unsigned int host_cpu;
+int host_fake_clock;
+uint64_t host_fake_counter;
+uint64_t host_timer_cval;
+int host_timer_enabled;
+
+// smp.c 不在主机上编译，由这里提供
+uint64_t cpu_online_mask = 1;
+
+// 链接脚本中的符号；主机上追踪偏移没有意义，给一个占位
+char _stext[1];
+
+static irq_handler_t host_irq_handlers[IRQ_MAX];
+
+uint64_t host_counter_read(void) {
+    struct timespec ts;
+
+    if (host_fake_clock) {
+        return __atomic_load_n(&host_fake_counter, __ATOMIC_RELAXED);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec) * HOST_COUNTER_FREQ / 1000000000ULL;
+}
+
+void host_clock_fake(uint64_t counter) {
+    host_fake_clock = 1;
+    host_fake_counter = counter;
+}
+
+void host_clock_real(void) {
+    host_fake_clock = 0;
+}
+
+void host_clock_advance_ns(uint64_t ns) {
+    host_fake_counter += ns * HOST_COUNTER_FREQ / 1000000000ULL;
+}
+
+int irq_register(uint32_t intid, irq_handler_t handler) {
+    if (intid >= IRQ_MAX) {
+        return -1;
+    }
+    host_irq_handlers[intid] = handler;
+    return 0;
+}
+
+void irq_enable(uint32_t intid) {
+    (void)intid;
+}
+
+void irq_disable(uint32_t intid) {
+    (void)intid;
+}
+
+int host_timer_fire_due(void) {
+    if (!host_timer_enabled || host_counter_read() < host_timer_cval) {
+        return 0;
+    }
+    if (host_irq_handlers[IRQ_PPI_VTIMER]) {
+        host_irq_handlers[IRQ_PPI_VTIMER](IRQ_PPI_VTIMER);
+    }
+    return 1;
+}
+
+uint64_t host_timer_run_all(uint64_t limit) {
+    uint64_t fired = 0;
+
+    while (host_timer_enabled && fired < limit) {
+        if (host_fake_counter < host_timer_cval) {
+            host_fake_counter = host_timer_cval;
+        }
+        host_timer_fire_due();
+        fired++;
+    }
+    return fired;
+}
+
+static int uart_capture;
+static char* uart_buf;
+static size_t uart_len;
+static size_t uart_cap;
+
+// 开启时清空缓冲，关闭后内容保留到下次开启
+void host_uart_capture(int enable) {
+    uart_capture = enable;
+    if (enable) {
+        uart_len = 0;
+        if (uart_buf) {
+            uart_buf[0] = '\0';
+        }
+    }
+}
+
+const char* host_uart_output(void) {
+    return uart_buf ? uart_buf : "";
+}
+
+// 只模拟 PL011 驱动，uart_puts 等格式化函数直接使用 src/kernel/uart_print.c
+void uart_init(void) {
+}
+
+void uart_putc(char c) {
+    if (!uart_capture) {
+        putchar(c);
+        return;
+    }
+    if (uart_len + 2 > uart_cap) {
+        uart_cap = uart_cap ? uart_cap * 2 : 4096;
+        uart_buf = realloc(uart_buf, uart_cap);
+        if (!uart_buf) {
+            abort();
+        }
+    }
+    uart_buf[uart_len++] = c;
+    uart_buf[uart_len] = '\0';
+}
@@ -0,0 +1,31 @@
+#include "harness.h"
+#include "host.h"
+#include "ktime.h"
+
+TEST(ktime_conversions_round_trip) {
+    clocksource_init();
+    EXPECT_EQ(clocksource.freq, HOST_COUNTER_FREQ);
+
+    // 62.5MHz 下每个周期正好 16ns
+    EXPECT_EQ(clocksource_cyc2ns(1), 16u);
+    EXPECT_EQ(clocksource_cyc2ns(62500000ULL), NSEC_PER_SEC);
+    EXPECT_EQ(clocksource_cyc2ns(62500000ULL * 86400 * 365), NSEC_PER_SEC * 86400 * 365);
+
+    for (uint64_t ns = 0; ns < 10 * NSEC_PER_SEC; ns = ns * 3 + 7) {
+        uint64_t cyc = clocksource_ns2cyc(ns);
+
+        // 比较值向上取整，换算回来不会早于目标时刻
+        EXPECT(clocksource_cyc2ns(cyc) >= ns);
+        EXPECT(clocksource_cyc2ns(cyc) - ns <= 2 * 16);
+    }
+}
+
+TEST(ktime_follows_counter) {
+    clocksource_init();
+    host_clock_fake(1000);
+    EXPECT_EQ(ktime_get_ns(), 16000u);
+
+    host_clock_advance_ns(NSEC_PER_MSEC);
+    EXPECT_EQ(ktime_get_ns(), 16000u + NSEC_PER_MSEC);
+    host_clock_real();
+}
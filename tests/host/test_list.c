@@ -0,0 +1,106 @@
+#include "harness.h"
+#include "hashtable.h"
+
+struct item {
+    struct list_head list;
+    struct hlist_node node;
+    uint64_t key;
+};
+
+static struct item items[64];
+
+TEST(list_add_del_order) {
+    struct list_head head;
+    struct item* pos;
+    struct item* tmp;
+    uint64_t expect = 0;
+
+    INIT_LIST_HEAD(&head);
+    EXPECT(list_empty(&head));
+
+    for (uint64_t i = 0; i < 8; i++) {
+        items[i].key = i;
+        list_add_tail(&items[i].list, &head);
+    }
+    list_for_each_entry(pos, &head, list) {
+        EXPECT_EQ(pos->key, expect);
+        expect++;
+    }
+    EXPECT_EQ(expect, 8u);
+
+    list_for_each_entry_safe(pos, tmp, &head, list) {
+        if (pos->key % 2) {
+            list_del(&pos->list);
+        }
+    }
+    expect = 0;
+    list_for_each_entry(pos, &head, list) {
+        EXPECT_EQ(pos->key, expect);
+        expect += 2;
+    }
+
+    list_add(&items[9].list, &head);
+    EXPECT(list_first_entry(&head, struct item, list) == &items[9]);
+}
+
+TEST(list_rcu_replace_and_delete) {
+    struct list_head head;
+    struct item* pos;
+    uint64_t sum = 0;
+
+    INIT_LIST_HEAD(&head);
+    for (uint64_t i = 0; i < 4; i++) {
+        items[i].key = i;
+        list_add_tail_rcu(&items[i].list, &head);
+    }
+
+    items[10].key = 10;
+    list_replace_rcu(&items[1].list, &items[10].list);
+    list_del_rcu(&items[2].list);
+
+    // 已删除的节点保留 next，正在其上的读者仍能走到链表尾
+    EXPECT(items[2].list.next == &items[3].list);
+
+    list_for_each_entry_rcu(pos, &head, list) {
+        sum += pos->key;
+    }
+    EXPECT_EQ(sum, 0u + 10 + 3);
+}
+
+TEST(hashtable_add_lookup_delete) {
+    static struct hlist_head table[1 << 4];
+    struct item* pos;
+
+    hash_init(table);
+    EXPECT_EQ(HASH_BITS(table), 4u);
+
+    for (uint64_t i = 0; i < 64; i++) {
+        items[i].key = i * 1000003;
+        hash_add_rcu(table, &items[i].node, items[i].key);
+    }
+
+    for (uint64_t i = 0; i < 64; i++) {
+        int found = 0;
+        hash_for_each_possible_rcu(table, pos, node, i * 1000003) {
+            if (pos->key == i * 1000003) {
+                found++;
+            }
+        }
+        EXPECT_EQ(found, 1);
+    }
+
+    for (uint64_t i = 0; i < 64; i += 2) {
+        hash_del_rcu(&items[i].node);
+        EXPECT(hlist_unhashed(&items[i].node));
+    }
+
+    for (uint64_t i = 0; i < 64; i++) {
+        int found = 0;
+        hash_for_each_possible(table, pos, node, i * 1000003) {
+            if (pos->key == i * 1000003) {
+                found++;
+            }
+        }
+        EXPECT_EQ(found, (int)(i % 2));
+    }
+}
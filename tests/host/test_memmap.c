@@ -0,0 +1,70 @@
+#include <efi.h>
+#include "harness.h"
+#include "boot_info.h"
+#include "compiler.h"
+
+EFI_STATUS ConvertMemoryMap(EFI_MEMORY_DESCRIPTOR* EfiMemoryMap, UINTN EfiMapSize, UINTN EfiDescSize, boot_info_t* boot_info);
+
+// 固件的描述符步长通常大于 sizeof(EFI_MEMORY_DESCRIPTOR)
+#define FIRMWARE_DESC_SIZE 48
+
+static uint8_t efi_map[FIRMWARE_DESC_SIZE * 600];
+
+static EFI_MEMORY_DESCRIPTOR* efi_desc(UINTN i) {
+    return (EFI_MEMORY_DESCRIPTOR*)(efi_map + i * FIRMWARE_DESC_SIZE);
+}
+
+TEST(memmap_converts_types_and_fields) {
+    boot_info_t info = {0};
+
+    for (UINTN i = 0; i < EfiMaxMemoryType; i++) {
+        EFI_MEMORY_DESCRIPTOR* d = efi_desc(i);
+
+        d->Type = (UINT32)i;
+        d->PhysicalStart = 0x40000000ULL + i * EFI_PAGE_SIZE * 16;
+        d->VirtualStart = 0x1000 * i;
+        d->NumberOfPages = 16 + i;
+        d->Attribute = MEMORY_ATTR_WB | (i << 20);
+    }
+
+    ASSERT(ConvertMemoryMap((EFI_MEMORY_DESCRIPTOR*)efi_map, EfiMaxMemoryType * FIRMWARE_DESC_SIZE,
+                            FIRMWARE_DESC_SIZE, &info) == EFI_SUCCESS);
+
+    EXPECT_EQ(info.memory_map_desc_count, (uintn_t)EfiMaxMemoryType);
+    EXPECT_EQ(info.memory_map_desc_size, sizeof(memory_descriptor_t));
+    EXPECT_EQ(info.memory_map_size, EfiMaxMemoryType * sizeof(memory_descriptor_t));
+
+    for (UINTN i = 0; i < EfiMaxMemoryType; i++) {
+        memory_descriptor_t* k = &info.memory_map_base[i];
+
+        EXPECT_EQ(k->type, (uint32_t)i);
+        EXPECT_EQ(k->pad, 0u);
+        EXPECT_EQ(k->physical_start, efi_desc(i)->PhysicalStart);
+        EXPECT_EQ(k->virtual_start, efi_desc(i)->VirtualStart);
+        EXPECT_EQ(k->number_of_pages, efi_desc(i)->NumberOfPages);
+        EXPECT_EQ(k->attribute, efi_desc(i)->Attribute);
+    }
+}
+
+TEST(memmap_unknown_type_is_reserved) {
+    boot_info_t info = {0};
+
+    efi_desc(0)->Type = 0x70000000;
+    efi_desc(1)->Type = EfiConventionalMemory;
+
+    ASSERT(ConvertMemoryMap((EFI_MEMORY_DESCRIPTOR*)efi_map, 2 * FIRMWARE_DESC_SIZE,
+                            FIRMWARE_DESC_SIZE, &info) == EFI_SUCCESS);
+    EXPECT_EQ(info.memory_map_base[0].type, (uint32_t)MEMORY_TYPE_RESERVED);
+    EXPECT_EQ(info.memory_map_base[1].type, (uint32_t)MEMORY_TYPE_CONVENTIONAL);
+}
+
+TEST(memmap_rejects_bad_input) {
+    boot_info_t info = {0};
+
+    EXPECT_EQ(ConvertMemoryMap(NULL, FIRMWARE_DESC_SIZE, FIRMWARE_DESC_SIZE, &info), EFI_INVALID_PARAMETER);
+    EXPECT_EQ(ConvertMemoryMap((EFI_MEMORY_DESCRIPTOR*)efi_map, FIRMWARE_DESC_SIZE, FIRMWARE_DESC_SIZE, NULL),
+              EFI_INVALID_PARAMETER);
+    EXPECT_EQ(ConvertMemoryMap((EFI_MEMORY_DESCRIPTOR*)efi_map, 513 * FIRMWARE_DESC_SIZE, FIRMWARE_DESC_SIZE, &info),
+              EFI_OUT_OF_RESOURCES);
+    EXPECT(info.memory_map_base == NULL);
+}
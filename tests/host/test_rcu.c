@@ -0,0 +1,197 @@
+#include "harness.h"
+#include "host.h"
+#include "rcu.h"
+#include "smp.h"
+
+// 在单线程里切换 host_cpu 模拟多个 CPU，使宽限期推进完全确定
+
+extern void (*rcu_host_gp_hook)(void);
+
+static int invoked;
+
+static void count_cb(struct rcu_head* head) {
+    (void)head;
+    invoked++;
+}
+
+static void rcu_setup(uint64_t online) {
+    rcu_init();
+    cpu_online_mask = online;
+    for (unsigned int cpu = 0; cpu < NR_CPUS; cpu++) {
+        if (online & (1ULL << cpu)) {
+            rcu_cpu_online(cpu);
+        }
+    }
+    arch_set_cpu_id(0);
+    invoked = 0;
+}
+
+static void qs_on(unsigned int cpu) {
+    arch_set_cpu_id(cpu);
+    rcu_note_context_switch();
+    arch_set_cpu_id(0);
+}
+
+TEST(rcu_single_cpu_callback_after_qs) {
+    struct rcu_head head;
+
+    rcu_setup(0x1);
+    call_rcu(&head, count_cb);
+    EXPECT_EQ(invoked, 0);
+
+    // 第一次静止状态开始宽限期并报告，第二次执行回调
+    rcu_note_context_switch();
+    rcu_note_context_switch();
+    EXPECT_EQ(invoked, 1);
+}
+
+TEST(rcu_waits_for_every_online_cpu) {
+    struct rcu_head head;
+
+    rcu_setup(0x7);
+    call_rcu(&head, count_cb);
+
+    for (int i = 0; i < 4; i++) {
+        qs_on(0);
+        qs_on(1);
+    }
+    EXPECT_EQ(invoked, 0);
+
+    qs_on(2);
+    qs_on(0);
+    EXPECT_EQ(invoked, 1);
+}
+
+TEST(rcu_idle_cpu_does_not_block) {
+    struct rcu_head head;
+
+    rcu_setup(0x3);
+    arch_set_cpu_id(1);
+    rcu_idle_enter();
+    arch_set_cpu_id(0);
+
+    call_rcu(&head, count_cb);
+    qs_on(0);
+    qs_on(0);
+    EXPECT_EQ(invoked, 1);
+
+    // 退出 idle 后又需要它的静止状态
+    arch_set_cpu_id(1);
+    rcu_idle_exit();
+    arch_set_cpu_id(0);
+
+    call_rcu(&head, count_cb);
+    qs_on(0);
+    qs_on(0);
+    EXPECT_EQ(invoked, 1);
+    qs_on(1);
+    qs_on(0);
+    EXPECT_EQ(invoked, 2);
+}
+
+TEST(rcu_late_callback_waits_for_next_gp) {
+    struct rcu_head first;
+    struct rcu_head second;
+
+    rcu_setup(0x3);
+    call_rcu(&first, count_cb);
+    qs_on(0);                   // 开始宽限期 1
+
+    arch_set_cpu_id(1);
+    call_rcu(&second, count_cb);
+    arch_set_cpu_id(0);
+
+    qs_on(1);                   // CPU1 报告宽限期 1，并为 second 请求宽限期 2
+    qs_on(0);                   // 宽限期 1 结束，执行 first；宽限期 2 开始
+    EXPECT_EQ(invoked, 1);
+
+    qs_on(0);
+    EXPECT_EQ(invoked, 1);      // CPU1 在宽限期 2 中还没有静止状态
+
+    qs_on(1);
+    qs_on(1);
+    EXPECT_EQ(invoked, 2);
+}
+
+TEST(rcu_callbacks_run_in_batches) {
+    static struct rcu_head heads[40];
+
+    rcu_setup(0x1);
+    for (int i = 0; i < 40; i++) {
+        call_rcu(&heads[i], count_cb);
+    }
+    rcu_note_context_switch();
+    rcu_note_context_switch();
+    EXPECT_EQ(invoked, 16);
+    rcu_note_context_switch();
+    EXPECT_EQ(invoked, 32);
+    rcu_check_callbacks();
+    EXPECT_EQ(invoked, 40);
+}
+
+// CPU1 在宽限期读取 idle_mask 之后、发布 qs_mask 之前进入 idle，
+// 它看不到自己的位，只能由宽限期一方代为报告
+static void cpu1_enter_idle(void) {
+    rcu_host_gp_hook = NULL;
+    arch_set_cpu_id(1);
+    rcu_idle_enter();
+    arch_set_cpu_id(0);
+}
+
+TEST(rcu_idle_enter_during_gp_start) {
+    struct rcu_head head;
+
+    rcu_setup(0x3);
+    call_rcu(&head, count_cb);
+
+    rcu_host_gp_hook = cpu1_enter_idle;
+    qs_on(0);                   // 开始宽限期，期间 CPU1 进入 idle
+    EXPECT(rcu_host_gp_hook == NULL);
+
+    qs_on(0);
+    qs_on(0);
+    EXPECT_EQ(invoked, 1);
+
+    arch_set_cpu_id(1);
+    rcu_idle_exit();
+    arch_set_cpu_id(0);
+}
+
+TEST(rcu_irq_from_idle_is_a_reader) {
+    struct rcu_head head;
+
+    rcu_setup(0x3);
+    arch_set_cpu_id(1);
+    rcu_idle_enter();
+    rcu_irq_enter();            // 中断打断 CPU1 的 idle，处理函数里可能有读者
+    arch_set_cpu_id(0);
+
+    call_rcu(&head, count_cb);
+    qs_on(0);
+    qs_on(0);
+    qs_on(0);
+    EXPECT_EQ(invoked, 0);
+
+    arch_set_cpu_id(1);
+    rcu_irq_exit();             // 回到 idle 即报告静止状态
+    arch_set_cpu_id(0);
+    qs_on(0);
+    EXPECT_EQ(invoked, 1);
+
+    // 再次进入宽限期时 CPU1 仍按 idle 跳过
+    call_rcu(&head, count_cb);
+    qs_on(0);
+    qs_on(0);
+    EXPECT_EQ(invoked, 2);
+
+    arch_set_cpu_id(1);
+    rcu_idle_exit();
+    arch_set_cpu_id(0);
+}
+
+TEST(rcu_synchronize_single_cpu) {
+    rcu_setup(0x1);
+    synchronize_rcu();
+    synchronize_rcu();
+    EXPECT_EQ(invoked, 0);
+}
@@ -0,0 +1,81 @@
+#include "harness.h"
+#include "string.h"
+
+static uint8_t src_buf[256];
+static uint8_t dst_buf[256];
+static uint8_t ref_buf[256];
+
+static void fill_pattern(uint8_t* buf, uint64_t n, uint8_t seed) {
+    for (uint64_t i = 0; i < n; i++) {
+        buf[i] = (uint8_t)(seed + i * 7);
+    }
+}
+
+TEST(string_memset_all_alignments) {
+    for (int off = 0; off < 8; off++) {
+        for (int len = 0; len < 70; len++) {
+            fill_pattern(dst_buf, sizeof(dst_buf), 1);
+            fill_pattern(ref_buf, sizeof(ref_buf), 1);
+            for (int i = 0; i < len; i++) {
+                ref_buf[off + i] = 0xA5;
+            }
+
+            EXPECT(memset(dst_buf + off, 0xA5, len) == dst_buf + off);
+            EXPECT_EQ(memcmp(dst_buf, ref_buf, sizeof(dst_buf)), 0);
+        }
+    }
+}
+
+TEST(string_memcpy_all_alignments) {
+    fill_pattern(src_buf, sizeof(src_buf), 3);
+
+    for (int soff = 0; soff < 8; soff++) {
+        for (int doff = 0; doff < 8; doff++) {
+            for (int len = 0; len < 70; len++) {
+                fill_pattern(dst_buf, sizeof(dst_buf), 9);
+                fill_pattern(ref_buf, sizeof(ref_buf), 9);
+                for (int i = 0; i < len; i++) {
+                    ref_buf[doff + i] = src_buf[soff + i];
+                }
+
+                EXPECT(memcpy(dst_buf + doff, src_buf + soff, len) == dst_buf + doff);
+                EXPECT_EQ(memcmp(dst_buf, ref_buf, sizeof(dst_buf)), 0);
+            }
+        }
+    }
+}
+
+TEST(string_memmove_overlap) {
+    for (int shift = -9; shift <= 9; shift++) {
+        fill_pattern(dst_buf, sizeof(dst_buf), 5);
+        fill_pattern(ref_buf, sizeof(ref_buf), 5);
+
+        uint8_t tmp[100];
+        for (int i = 0; i < 100; i++) {
+            tmp[i] = ref_buf[64 + i];
+        }
+        for (int i = 0; i < 100; i++) {
+            ref_buf[64 + shift + i] = tmp[i];
+        }
+
+        memmove(dst_buf + 64 + shift, dst_buf + 64, 100);
+        EXPECT_EQ(memcmp(dst_buf, ref_buf, sizeof(dst_buf)), 0);
+    }
+}
+
+TEST(string_compare) {
+    EXPECT_EQ(memcmp("abc", "abc", 3), 0);
+    EXPECT(memcmp("abc", "abd", 3) < 0);
+    EXPECT(memcmp("\xff", "\x01", 1) > 0);
+
+    EXPECT_EQ(strlen(""), 0u);
+    EXPECT_EQ(strlen("RLOS kernel"), 11u);
+
+    EXPECT_EQ(strcmp("kernel", "kernel"), 0);
+    EXPECT(strcmp("kernel", "kernels") < 0);
+    EXPECT(strcmp("b", "a") > 0);
+
+    EXPECT_EQ(strncmp("kernel.elf", "kernel.efi", 8), 0);
+    EXPECT(strncmp("kernel.elf", "kernel.efi", 9) != 0);
+    EXPECT_EQ(strncmp("abc", "abd", 0), 0);
+}
@@ -0,0 +1,239 @@
+#include <pthread.h>
+#include <time.h>
+
+#include "harness.h"
+#include "host.h"
+#include "timer.h"
+
+extern void (*timer_host_migrate_hook)(struct timer* timer);
+
+#define TEST_TIMERS 20000
+
+struct test_timer {
+    struct timer timer;
+    int fired;
+    uint64_t fired_at;
+    int rearm;
+};
+
+static struct test_timer timers[TEST_TIMERS];
+static int fire_order[16];
+static int fire_count;
+
+static void record_fire(struct timer* timer) {
+    struct test_timer* t = container_of(timer, struct test_timer, timer);
+
+    t->fired++;
+    t->fired_at = ktime_get_ns();
+    if (fire_count < 16) {
+        fire_order[fire_count] = (int)(t - timers);
+    }
+    fire_count++;
+
+    if (t->rearm) {
+        t->rearm--;
+        timer_start(timer, timer->expires + 3 * TIMER_TICK_NS);
+    }
+}
+
+static void timer_setup(uint64_t start_ns) {
+    host_clock_fake(start_ns / 16);
+    timers_init();
+    timer_cpu_init();
+    fire_count = 0;
+    for (int i = 0; i < TEST_TIMERS; i++) {
+        timer_init(&timers[i].timer, record_fire);
+        timers[i].fired = 0;
+        timers[i].fired_at = 0;
+        timers[i].rearm = 0;
+    }
+}
+
+static uint64_t now(void) {
+    return ktime_get_ns();
+}
+
+TEST(timer_heap_orders_sub_tick_deadlines) {
+    timer_setup(5 * NSEC_PER_SEC);
+    uint64_t base = now();
+
+    timer_start(&timers[0].timer, base + 900 * NSEC_PER_USEC);
+    timer_start(&timers[1].timer, base + 100 * NSEC_PER_USEC);
+    timer_start(&timers[2].timer, base + 500 * NSEC_PER_USEC);
+    EXPECT(timers[1].timer.state == TIMER_HEAP);
+
+    host_timer_run_all(100);
+    EXPECT_EQ(fire_count, 3);
+    EXPECT_EQ(fire_order[0], 1);
+    EXPECT_EQ(fire_order[1], 2);
+    EXPECT_EQ(fire_order[2], 0);
+
+    // 堆上的定时器精确到比较器分辨率
+    for (int i = 0; i < 3; i++) {
+        EXPECT(timers[i].fired_at >= timers[i].timer.expires);
+        EXPECT(timers[i].fired_at - timers[i].timer.expires < 100);
+    }
+    EXPECT(!host_timer_enabled);
+}
+
+TEST(timer_wheel_never_early_within_one_tick) {
+    uint64_t seed = 12345;
+
+    timer_setup(NSEC_PER_SEC);
+    uint64_t base = now();
+
+    for (int i = 0; i < TEST_TIMERS; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        // 覆盖 tv1 到第三层的范围
+        timer_start(&timers[i].timer, base + 2 * TIMER_TICK_NS + (seed >> 20) % (30ULL * NSEC_PER_SEC));
+    }
+
+    host_timer_run_all(1ULL << 24);
+
+    int wrong = 0;
+    for (int i = 0; i < TEST_TIMERS; i++) {
+        if (timers[i].fired != 1 ||
+            timers[i].fired_at < timers[i].timer.expires ||
+            timers[i].fired_at - timers[i].timer.expires >= TIMER_TICK_NS) {
+            wrong++;
+        }
+    }
+    EXPECT_EQ(wrong, 0);
+    EXPECT_EQ(fire_count, TEST_TIMERS);
+}
+
+TEST(timer_cancel_wheel_and_heap) {
+    timer_setup(NSEC_PER_SEC);
+    uint64_t base = now();
+
+    for (int i = 0; i < 1000; i++) {
+        uint64_t delta = (i % 2) ? 200 * NSEC_PER_USEC : (uint64_t)(i + 2) * TIMER_TICK_NS;
+        timer_start(&timers[i].timer, base + delta);
+    }
+    for (int i = 0; i < 1000; i += 3) {
+        EXPECT_EQ(timer_cancel(&timers[i].timer), 1);
+        EXPECT(!timer_pending(&timers[i].timer));
+    }
+    EXPECT_EQ(timer_cancel(&timers[0].timer), 0);
+
+    host_timer_run_all(1 << 20);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(timers[i].fired, (i % 3) ? 1 : 0);
+    }
+}
+
+TEST(timer_far_future_cascades) {
+    timer_setup(NSEC_PER_SEC);
+    uint64_t base = now();
+
+    // 分别落在 tvn[1] 和 tvn[2] 范围
+    timer_start(&timers[0].timer, base + 20ULL * NSEC_PER_SEC);
+    timer_start(&timers[1].timer, base + 3600ULL * NSEC_PER_SEC);
+
+    host_timer_run_all(1ULL << 26);
+    EXPECT_EQ(timers[0].fired, 1);
+    EXPECT_EQ(timers[1].fired, 1);
+    EXPECT(timers[1].fired_at >= timers[1].timer.expires);
+    EXPECT(timers[1].fired_at - timers[1].timer.expires < TIMER_TICK_NS);
+}
+
+TEST(timer_idle_wheel_is_tickless) {
+    timer_setup(NSEC_PER_SEC);
+    uint64_t base = now();
+
+    // 只挂一个 1 小时的超时：比较器只在逐层迁移和到期时触发
+    timer_start(&timers[0].timer, base + 3600ULL * NSEC_PER_SEC);
+    uint64_t irqs = host_timer_run_all(1ULL << 26);
+
+    EXPECT(irqs <= 6);
+    EXPECT_EQ(timers[0].fired, 1);
+    EXPECT(timers[0].fired_at >= timers[0].timer.expires);
+    EXPECT(timers[0].fired_at - timers[0].timer.expires < TIMER_TICK_NS);
+    EXPECT(!host_timer_enabled);
+}
+
+TEST(timer_rearm_from_callback_and_restart) {
+    timer_setup(NSEC_PER_SEC);
+    uint64_t base = now();
+
+    timers[0].rearm = 3;
+    timer_start(&timers[0].timer, base + 2 * TIMER_TICK_NS);
+
+    // 重新启动会替换原来的截止时间
+    timer_start(&timers[1].timer, base + 50 * TIMER_TICK_NS);
+    timer_start(&timers[1].timer, base + 10 * TIMER_TICK_NS);
+
+    host_timer_run_all(1 << 20);
+    EXPECT_EQ(timers[0].fired, 4);
+    EXPECT_EQ(timers[1].fired, 1);
+    EXPECT(timers[1].fired_at < base + 11 * TIMER_TICK_NS);
+}
+
+TEST(timer_heap_overflow_falls_back_to_wheel) {
+    timer_setup(NSEC_PER_SEC);
+    uint64_t base = now();
+
+    for (int i = 0; i < HRTIMER_HEAP_SIZE + 10; i++) {
+        timer_start(&timers[i].timer, base + 300 * NSEC_PER_USEC);
+    }
+    EXPECT(timers[HRTIMER_HEAP_SIZE + 5].timer.state == TIMER_WHEEL);
+
+    host_timer_run_all(1 << 20);
+    EXPECT_EQ(fire_count, HRTIMER_HEAP_SIZE + 10);
+}
+
+// CPU0 上的 timer_cancel 与把定时器迁到 CPU1 的 timer_start 交错：
+// 取消方在迁移窗口内开始，必须等迁移完成后在新 base 上摘除
+struct migrate_race {
+    pthread_t thread;
+    struct timer* timer;
+    int done_in_window;
+    int cancelled;
+    int done;
+};
+
+static struct migrate_race race;
+
+static void* race_cancel(void* arg) {
+    (void)arg;
+    arch_set_cpu_id(0);
+    race.cancelled = timer_cancel(race.timer);
+    __atomic_store_n(&race.done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void race_in_window(struct timer* timer) {
+    struct timespec delay = { 0, 20 * 1000 * 1000 };
+
+    timer_host_migrate_hook = NULL;
+    race.timer = timer;
+    pthread_create(&race.thread, NULL, race_cancel, NULL);
+    nanosleep(&delay, NULL);
+    race.done_in_window = __atomic_load_n(&race.done, __ATOMIC_ACQUIRE);
+}
+
+TEST(timer_cancel_during_migration) {
+    timer_setup(NSEC_PER_SEC);
+    uint64_t base = now();
+
+    timer_start(&timers[0].timer, base + 5 * TIMER_TICK_NS);
+
+    race.done = 0;
+    arch_set_cpu_id(1);
+    timer_cpu_init();
+    timer_host_migrate_hook = race_in_window;
+    timer_start(&timers[0].timer, base + 10 * TIMER_TICK_NS);
+    pthread_join(race.thread, NULL);
+    EXPECT(timer_host_migrate_hook == NULL);
+
+    EXPECT_EQ(race.done_in_window, 0);
+    EXPECT_EQ(race.cancelled, 1);
+    EXPECT(!timer_pending(&timers[0].timer));
+
+    // 两个 base 都保持一致：CPU1 上新的定时器照常触发，旧定时器不再触发
+    timer_start(&timers[1].timer, base + 3 * TIMER_TICK_NS);
+    host_timer_run_all(1 << 10);
+    arch_set_cpu_id(0);
+    EXPECT_EQ(timers[0].fired, 0);
+    EXPECT_EQ(timers[1].fired, 1);
+}
@@ -0,0 +1,114 @@
+#include "harness.h"
+#include "host.h"
+#include "trace.h"
+
+static int count_lines(const char* text, const char* prefix) {
+    int count = 0;
+    const char* line = text;
+
+    while (*line) {
+        int i = 0;
+        while (prefix[i] && line[i] == prefix[i]) {
+            i++;
+        }
+        if (!prefix[i]) {
+            count++;
+        }
+        while (*line && *line != '\n') {
+            line++;
+        }
+        if (*line) {
+            line++;
+        }
+    }
+    return count;
+}
+
+static int has_prefix(const char* str, const char* prefix) {
+    while (*prefix && *str == *prefix) {
+        str++;
+        prefix++;
+    }
+    return !*prefix;
+}
+
+// 第 index 条 TRACE 记录行，index 为 -1 时取最后一条
+static const char* trace_line(const char* text, int index) {
+    const char* found = NULL;
+    const char* line = text;
+    int n = 0;
+
+    while (*line) {
+        if (has_prefix(line, "TRACE ")) {
+            if (n++ == index) {
+                return line;
+            }
+            found = line;
+        }
+        while (*line && *line != '\n') {
+            line++;
+        }
+        if (*line) {
+            line++;
+        }
+    }
+    return index < 0 ? found : NULL;
+}
+
+// "TRACE 0x<ts> " 之后是 id|cpu|phase|arg0 字段
+#define TRACE_WORD_OFFSET 25
+
+TEST(trace_disabled_records_nothing) {
+    trace_start();
+    trace_stop();
+
+    trace_instant(TRACE_WAKEUP, 1, 2, 3);
+
+    host_uart_capture(1);
+    trace_dump();
+    host_uart_capture(0);
+    EXPECT_EQ(count_lines(host_uart_output(), "TRACE "), 0);
+    EXPECT_EQ(count_lines(host_uart_output(), "TRACE-BEGIN"), 1);
+    EXPECT_EQ(count_lines(host_uart_output(), "TRACE-END"), 1);
+}
+
+TEST(trace_dump_format) {
+    host_clock_fake(0x1234);
+    trace_start();
+    trace_begin(TRACE_IRQ, 27, 0, 0);
+    trace_end(TRACE_IRQ, 27, 0, 0);
+    trace_stop();
+    host_clock_real();
+
+    host_uart_capture(1);
+    trace_dump();
+    host_uart_capture(0);
+
+    const char* out = host_uart_output();
+    EXPECT_EQ(count_lines(out, "TRACE "), 2);
+    EXPECT_EQ(count_lines(out, "TRACE 0x0000000000001234 0x0000001B01000001 "), 1);
+    EXPECT_EQ(count_lines(out, "TRACE 0x0000000000001234 0x0000001B02000001 "), 1);
+}
+
+TEST(trace_buffer_wraps) {
+    trace_start();
+    for (int i = 0; i < 5000; i++) {
+        trace_instant(TRACE_WAKEUP, (uint32_t)i, 0, 0);
+    }
+    trace_stop();
+
+    host_uart_capture(1);
+    trace_dump();
+    host_uart_capture(0);
+
+    // 只保留最新的 4096 条，最旧的一条是第 904 个事件
+    const char* out = host_uart_output();
+    EXPECT_EQ(count_lines(out, "TRACE "), 4096);
+    EXPECT_EQ(count_lines(out, "TRACE-BEGIN"), 1);
+
+    const char* first = trace_line(out, 0);
+    const char* last = trace_line(out, -1);
+    ASSERT(first && last);
+    EXPECT(has_prefix(first + TRACE_WORD_OFFSET, "0x0000038800000003 "));
+    EXPECT(has_prefix(last + TRACE_WORD_OFFSET, "0x0000138700000003 "));
+}
@@ -0,0 +1,100 @@
+#!/bin/bash
+
+# RLOS - headless QEMU smoke run
+# 用法: tests/smoke.sh [镜像目录，默认 build]
+# 启动该目录下已编译好的 bootloader.efi/kernel.elf（make smoke 传入单独的 BENCH=1 构建目录），
+# 把串口输出写入日志，
+# 等到 BENCH-DONE 或超时后检查：
+#   - 内核打印出 CPUs Online 且数量等于 SMP
+#   - 没有 Unhandled exception
+#   - 出现 BENCH-DONE
+# 通过时把 BENCH 行单独存到 $SMOKE_DIR/bench.txt，并用 tools/bench_compare.py
+# 与 $BENCH_BASELINE 比较（该文件不存在时以本次结果作为基线）：
+#   BENCH_TOLERANCE  允许的变化百分比，默认 10
+#   BENCH_STRICT=1   有退化时本脚本失败，否则只报告
+#   BENCH_UPDATE=1   比较后用本次结果替换基线
+set -u
+
+QEMU_SYSTEM_AARCH64="qemu-system-aarch64"
+UEFI_CODE_PATH="/usr/share/AAVMF/AAVMF_CODE.fd"
+UEFI_VARS_PATH="/usr/share/AAVMF/AAVMF_VARS.fd"
+QEMU_SMP="${SMP:-4}"
+SMOKE_TIMEOUT="${SMOKE_TIMEOUT:-120}"
+SMOKE_DIR="${SMOKE_DIR:-build/smoke}"
+IMAGE_DIR="${1:-build}"
+# 基线放在 $SMOKE_DIR 之外，每次运行开头清空 $SMOKE_DIR 不会影响它
+BENCH_BASELINE="${BENCH_BASELINE:-build/baseline/smoke-smp$QEMU_SMP.txt}"
+BENCH_TOLERANCE="${BENCH_TOLERANCE:-10}"
+BENCH_STRICT="${BENCH_STRICT:-0}"
+BENCH_UPDATE="${BENCH_UPDATE:-0}"
+
+LOG="$SMOKE_DIR/serial.log"
+ESP_DIR="$SMOKE_DIR/esp"
+VARS_PATH="$SMOKE_DIR/AAVMF_VARS.fd"
+
+fail() {
+    echo "SMOKE FAIL: $1"
+    if [ -f "$LOG" ]; then
+        echo "---- last serial output ----"
+        tail -n 40 "$LOG"
+    fi
+    exit 1
+}
+
+for f in "$IMAGE_DIR/bootloader.efi" "$IMAGE_DIR/kernel.elf" "$UEFI_CODE_PATH" "$UEFI_VARS_PATH"; do
+    [ -f "$f" ] || fail "missing $f"
+done
+command -v $QEMU_SYSTEM_AARCH64 > /dev/null 2>&1 || fail "$QEMU_SYSTEM_AARCH64 not found"
+
+rm -rf "$SMOKE_DIR"
+mkdir -p "$ESP_DIR/EFI/BOOT"
+cp "$IMAGE_DIR/bootloader.efi" "$ESP_DIR/EFI/BOOT/BOOTAA64.EFI"
+cp "$IMAGE_DIR/kernel.elf" "$ESP_DIR/kernel.elf"
+cp "$UEFI_VARS_PATH" "$VARS_PATH"
+: > "$LOG"
+
+$QEMU_SYSTEM_AARCH64 \
+    -machine virt,gic-version=3 \
+    -cpu cortex-a57 \
+    -smp "$QEMU_SMP" \
+    -m 512 \
+    -drive if=pflash,format=raw,file="$UEFI_CODE_PATH",readonly=on \
+    -drive if=pflash,format=raw,file="$VARS_PATH" \
+    -drive file=fat:rw:"$ESP_DIR",format=raw \
+    -display none \
+    -monitor none \
+    -serial file:"$LOG" &
+QEMU_PID=$!
+trap 'kill $QEMU_PID 2> /dev/null' EXIT
+
+START=$(date +%s)
+while kill -0 $QEMU_PID 2> /dev/null; do
+    if grep -q "BENCH-DONE\|Unhandled exception" "$LOG"; then
+        break
+    fi
+    if [ $(( $(date +%s) - START )) -ge "$SMOKE_TIMEOUT" ]; then
+        break
+    fi
+    sleep 1
+done
+kill $QEMU_PID 2> /dev/null
+wait $QEMU_PID 2> /dev/null
+ELAPSED=$(( $(date +%s) - START ))
+
+# 串口输出带 \r，先去掉再匹配
+tr -d '\r' < "$LOG" > "$LOG.txt"
+
+grep -q "Unhandled exception" "$LOG.txt" && fail "kernel took an unhandled exception"
+grep -q "^  CPUs Online: $QEMU_SMP\$" "$LOG.txt" || fail "expected $QEMU_SMP CPUs online"
+grep -q "^BENCH-DONE\$" "$LOG.txt" || fail "no BENCH-DONE within ${SMOKE_TIMEOUT}s"
+
+grep "^BENCH " "$LOG.txt" > "$SMOKE_DIR/bench.txt"
+cat "$SMOKE_DIR/bench.txt"
+
+COMPARE_ARGS=(--init --tolerance "$BENCH_TOLERANCE")
+[ "$BENCH_STRICT" = 1 ] || COMPARE_ARGS+=(--warn-only)
+[ "$BENCH_UPDATE" = 1 ] && COMPARE_ARGS+=(--update)
+python3 tools/bench_compare.py "${COMPARE_ARGS[@]}" "$BENCH_BASELINE" "$SMOKE_DIR/bench.txt" \
+    || fail "benchmark regression against $BENCH_BASELINE"
+
+echo "SMOKE PASS cpus=$QEMU_SMP bench_lines=$(wc -l < "$SMOKE_DIR/bench.txt") elapsed_s=$ELAPSED"
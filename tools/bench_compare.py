@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""Compare RLOS BENCH lines against a baseline and flag regressions.
+
+Both inputs are text containing lines of the form
+
+    BENCH <name> key=value key=value ...
+
+as printed by the in-kernel benchmarks (make BENCH=1, make smoke) and the
+host harness (make bench). Keys are classified by name:
+
+    *_ns, *_ns_x100, ns_per_op*        lower is better
+    *ops_per_sec, speedup_x100         higher is better
+    max_ns                             reported only (single worst sample)
+    anything else (cpus=, kind=, ...)  identifies the measurement
+
+Exit status is 1 if any metric got worse by more than the tolerance,
+unless --warn-only is given. With --init a missing baseline is created
+from the current results; --update replaces it after comparing.
+"""
+
+import argparse
+import os
+import shutil
+import sys
+
+INFO_ONLY = {"max_ns"}
+
+
+def direction(key):
+    """Return -1 if lower is better, +1 if higher is better, 0 if not a metric."""
+    if key.endswith("ops_per_sec") or key == "speedup_x100":
+        return 1
+    if key.endswith("_ns") or key.endswith("_ns_x100") or key.startswith("ns_per_op"):
+        return -1
+    return 0
+
+
+def parse(path):
+    """Return {identity: {metric: value}} for the BENCH lines in path."""
+    results = {}
+    with open(path, errors="replace") as f:
+        for line in f:
+            fields = line.strip().split()
+            if len(fields) < 2 or fields[0] != "BENCH":
+                continue
+            ident = [fields[1]]
+            metrics = {}
+            for field in fields[2:]:
+                key, sep, value = field.partition("=")
+                if not sep:
+                    continue
+                if direction(key):
+                    try:
+                        metrics[key] = float(value)
+                    except ValueError:
+                        pass
+                else:
+                    ident.append(field)
+            results[" ".join(ident)] = metrics
+    return results
+
+
+def save(current, baseline):
+    directory = os.path.dirname(baseline)
+    if directory:
+        os.makedirs(directory, exist_ok=True)
+    shutil.copyfile(current, baseline)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", help="file with baseline BENCH lines")
+    parser.add_argument("current", help="file with current BENCH lines")
+    parser.add_argument("--tolerance", type=float, default=10.0,
+                        help="allowed change in percent before a metric counts as a regression (default 10)")
+    parser.add_argument("--warn-only", action="store_true", help="report regressions but exit 0")
+    parser.add_argument("--init", action="store_true", help="create the baseline if it does not exist")
+    parser.add_argument("--update", action="store_true", help="replace the baseline with the current results")
+    args = parser.parse_args()
+
+    if not os.path.exists(args.baseline):
+        if not args.init:
+            sys.exit("bench_compare: baseline %s not found" % args.baseline)
+        save(args.current, args.baseline)
+        print("BENCH-COMPARE baseline saved to %s" % args.baseline)
+        return
+
+    base = parse(args.baseline)
+    cur = parse(args.current)
+    regressions = 0
+
+    for ident, metrics in cur.items():
+        if ident not in base:
+            print("NEW        %s" % ident)
+            continue
+        for key, value in metrics.items():
+            old = base[ident].get(key)
+            if old is None or old == 0:
+                continue
+            change = (value - old) / old * 100.0
+            worse = -change * direction(key)
+            if key in INFO_ONLY:
+                status = "INFO"
+            elif worse > args.tolerance:
+                status = "REGRESSION"
+                regressions += 1
+            elif -worse > args.tolerance:
+                status = "IMPROVED"
+            else:
+                status = "OK"
+            print("%-10s %s %s: %g -> %g (%+.1f%%)" % (status, ident, key, old, value, change))
+
+    for ident in base:
+        if ident not in cur:
+            print("MISSING    %s" % ident)
+
+    print("BENCH-COMPARE regressions=%d tolerance=%g%%" % (regressions, args.tolerance))
+    if args.update:
+        save(args.current, args.baseline)
+        print("BENCH-COMPARE baseline updated: %s" % args.baseline)
+    if regressions and not args.warn_only:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""Convert an RLOS trace dump (serial log) to Chrome/Perfetto trace JSON.
+
+The kernel prints the trace between TRACE-BEGIN and TRACE-END lines,
+see trace_dump() in src/kernel/trace.c. Event ids mirror src/include/trace.h.
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+EVENTS = {
+    1: "irq",
+    2: "timer_expire",
+    3: "wakeup",
+    4: "rcu_gp_start",
+    5: "rcu_gp_end",
+    6: "rcu_callbacks",
+    7: "smp_call",
+    8: "idle",
+    9: "func",
+}
+
+TRACE_FUNC = 9
+TRACE_SMP_CALL = 7
+PHASES = {0: "i", 1: "B", 2: "E"}
+
+BEGIN_RE = re.compile(r"TRACE-BEGIN freq=(\d+) cpus=(\d+)")
+ENTRY_RE = re.compile(r"TRACE (0x[0-9A-Fa-f]+) (0x[0-9A-Fa-f]+) (0x[0-9A-Fa-f]+) (0x[0-9A-Fa-f]+)")
+
+
+def load_symbols(elf):
+    """Return a sorted list of (address, name) for text symbols in kernel.elf."""
+    nm = os.environ.get("NM", "aarch64-linux-gnu-nm")
+    try:
+        out = subprocess.run([nm, "-n", elf], check=True, capture_output=True, text=True).stdout
+    except (OSError, subprocess.CalledProcessError):
+        print("warning: cannot run %s, function names unresolved" % nm, file=sys.stderr)
+        return []
+    syms = []
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 3 and parts[1] in "tTwW":
+            syms.append((int(parts[0], 16), parts[2]))
+    return syms
+
+
+def resolve(syms, addr):
+    lo, hi = 0, len(syms)
+    while lo < hi:
+        mid = (lo + hi) // 2
+        if syms[mid][0] <= addr:
+            lo = mid + 1
+        else:
+            hi = mid
+    return syms[lo - 1][1] if lo else "0x%x" % addr
+
+
+def parse(lines):
+    freq = None
+    entries = []
+    inside = False
+    for line in lines:
+        line = line.strip()
+        m = BEGIN_RE.search(line)
+        if m:
+            freq = int(m.group(1))
+            entries = []
+            inside = True
+            continue
+        if not inside:
+            continue
+        if "TRACE-END" in line:
+            inside = False
+            continue
+        m = ENTRY_RE.search(line)
+        if m:
+            entries.append(tuple(int(g, 16) for g in m.groups()))
+    if freq is None:
+        raise SystemExit("no TRACE-BEGIN found in input")
+    return freq, entries
+
+
+def convert(freq, entries, syms):
+    events = []
+    for ts, word, arg1, arg2 in entries:
+        ev_id = word & 0xFFFF
+        cpu = (word >> 16) & 0xFF
+        phase = (word >> 24) & 0xFF
+        arg0 = word >> 32
+
+        name = EVENTS.get(ev_id, "event_%d" % ev_id)
+        args = {"arg0": arg0, "arg1": arg1, "arg2": arg2}
+        if ev_id == TRACE_FUNC:
+            name = resolve(syms, arg1) if syms else "0x%x" % arg1
+            args = {"site": resolve(syms, arg2) if syms else "0x%x" % arg2}
+        elif ev_id == TRACE_SMP_CALL and phase == 1 and syms:
+            args["func"] = resolve(syms, arg1)
+
+        event = {
+            "name": name,
+            "ph": PHASES.get(phase, "i"),
+            "ts": ts * 1e6 / freq,
+            "pid": 0,
+            "tid": cpu,
+            "args": args,
+        }
+        if event["ph"] == "i":
+            event["s"] = "t"
+        events.append(event)
+
+    events.sort(key=lambda e: e["ts"])
+    for cpu in sorted({e["tid"] for e in events}):
+        events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": cpu,
+                       "args": {"name": "CPU %d" % cpu}})
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="serial log containing a trace dump ('-' for stdin)")
+    parser.add_argument("-o", "--output", default="-", help="output JSON file (default stdout)")
+    parser.add_argument("--elf", help="kernel.elf for resolving function names")
+    args = parser.parse_args()
+
+    if args.log == "-":
+        lines = sys.stdin.read().splitlines()
+    else:
+        with open(args.log, errors="replace") as f:
+            lines = f.read().splitlines()
+
+    freq, entries = parse(lines)
+    syms = load_symbols(args.elf) if args.elf and os.path.exists(args.elf) else []
+    trace = convert(freq, entries, syms)
+
+    if args.output == "-":
+        json.dump(trace, sys.stdout)
+    else:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+    print("%d events" % len(entries), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()